@@ -4,6 +4,9 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <cstddef>
+
 #include "units.hpp"
 
 #include "f4.hpp"
@@ -24,52 +27,107 @@ namespace bsp
 		using B1 =
 			stm32::f4::GpioPin<stm32::f4::GpioC, 13, stm32::f4::GpioPinMode::Input>; //!< Blue user button at PC13
 
+		using Pins = stm32::f4::GpioConfig<LD_Green, LD_Blue, LD_Red, B1>; //!< All board pins, set up at once
+
 		/**
 		 * @brief Supply voltage in mV.
 		 *
 		 */
 		static constexpr utils::quantity::mv_t supply_voltage = 3300 * utils::unit::mV;
 
+		/**
+		 * @brief 8 MHz clock from the ST-LINK MCO, fed into HSE bypass.
+		 *
+		 */
+		static constexpr mcal::clock external_clock = {8 * utils::unit::MHz, mcal::clock::sources::clock};
+
 		/**
 		 * @brief Clock tree configuration.
 		 *
 		 */
-		using clock = stm32::f4::clock_tree<target_system_clock, {8 * utils::unit::MHz, mcal::clock::sources::clock}>;
+		using clock = stm32::f4::clock_tree<target_system_clock, external_clock>;
 
-		using Delay = stm32::f4::DelayImpl<target_system_clock>; //!< System clock based delay utility
+		using flash = stm32::f4::flash<supply_voltage>; //!< Flash latency and ART accelerator
 
 		/**
-		 * @brief Initialize the board peripherals.
+		 * @brief Clock profiles selectable at runtime, one per HCLK frequency.
 		 *
 		 */
-		static inline void init() noexcept
+		template <utils::quantity::Hz_t... frequencies>
+		using clock_profiles =
+			stm32::f4::clock_profiles<supply_voltage, stm32::f4::clock_tree<frequencies, external_clock>...>;
+
+		using Delay = stm32::f4::SleepDelayImpl<stm32::f4::Timer5, clock::timer_clock1()>; //!< Delay sleeping on TIM5
+		using BusyDelay = stm32::f4::DelayImpl<clock::hclk()>;							 //!< Busy-waiting delay
+		using ScaledDelay = stm32::f4::SystemClockDelay; //!< Delay following runtime clock profile switches
+
+		static_assert(mcal::concepts::Delay<Delay>);
+
+		/**
+		 * @brief 64-bit monotonic µs clock on TIM2, start with Timebase::init().
+		 *
+		 */
+		using Timebase = stm32::f4::MonotonicClockImpl<stm32::f4::Timer2, clock::timer_clock1()>;
+
+		static_assert(mcal::concepts::Clock<Timebase>);
+
+		/**
+		 * @brief Keep Timebase and Delay at 1 µs ticks after a clock profile switch.
+		 *
+		 * Both timers run on the APB1 timer clock, which changes with the
+		 * profile. Call from the listener installed with Profiles::on_change():
+		 * @code
+		 * static void on_clock_change(utils::quantity::Hz_t) noexcept
+		 * {
+		 *     board::retune_timers<profiles>();
+		 * }
+		 * @endcode
+		 *
+		 * @tparam Profiles Clock profiles of this board (see clock_profiles)
+		 */
+		template <typename Profiles>
+		static void retune_timers() noexcept
 		{
-			// Configure Flash latency according to RM0390, Table 5
-			if constexpr (supply_voltage > 2700 * utils::unit::mV)
+			static_assert(std::ranges::all_of(Profiles::timer_clocks1, stm32::f4::is_us_timer_clock),
+						  "APB1 timer clock of every profile must be a multiple of 1 MHz for µs ticks");
+
+			const std::size_t index = Profiles::current();
+			if (index < Profiles::count)
 			{
-				using namespace stm32::f4;
-
-				if constexpr (target_system_clock < 30 * utils::unit::MHz)
-					FLASH->ACR |= FLASH_ACR_LATENCY_0WS;
-				else if constexpr (target_system_clock < 60 * utils::unit::MHz)
-					FLASH->ACR |= FLASH_ACR_LATENCY_1WS;
-				else if constexpr (target_system_clock < 90 * utils::unit::MHz)
-					FLASH->ACR |= FLASH_ACR_LATENCY_2WS;
-				else if constexpr (target_system_clock < 120 * utils::unit::MHz)
-					FLASH->ACR |= FLASH_ACR_LATENCY_3WS;
-				else if constexpr (target_system_clock < 150 * utils::unit::MHz)
-					FLASH->ACR |= FLASH_ACR_LATENCY_4WS;
-				else if constexpr (target_system_clock < 180 * utils::unit::MHz)
-					FLASH->ACR |= FLASH_ACR_LATENCY_5WS;
+				Timebase::set_timer_clock(Profiles::timer_clocks1[index]);
+				Delay::set_timer_clock(Profiles::timer_clocks1[index]);
 			}
+		}
 
-			// Initialize clock tree and peripherals
+		/**
+		 * @brief Configure flash latency and the clock tree.
+		 *
+		 * Does not depend on initialised .data/.bss and may therefore be
+		 * called from the SystemEarlyInit() hook in Reset_Handler:
+		 * @code
+		 * extern "C" void SystemEarlyInit() { board::init_clock(); }
+		 * @endcode
+		 */
+		static inline void init_clock() noexcept
+		{
+			flash::template configure<clock::hclk()>();
 			clock::init();
+		}
+
+		/**
+		 * @brief Initialize the board peripherals.
+		 *
+		 * The clock tree is only configured if init_clock() did not run yet.
+		 *
+		 */
+		static inline void init() noexcept
+		{
+			if (!clock::is_configured() || !flash::template is_configured<clock::hclk()>())
+			{
+				init_clock();
+			}
 			stm32::f4::init_print();
-			LD_Green::init();
-			LD_Blue::init();
-			LD_Red::init();
-			B1::init();
+			Pins::init();
 		}
 	};
 } // namespace bsp
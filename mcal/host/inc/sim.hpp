@@ -0,0 +1,167 @@
+/**
+ * @file sim.hpp
+ * @brief Simulated peripheral backend for host builds of the MCAL.
+ *
+ * In host builds (MCAL_HOST) every peripheral address is backed by a
+ * simulated register file instead of real hardware. All accesses made
+ * through Register are routed over a simulated bus which counts and
+ * timestamps them, so unit tests and benchmarks can assert the exact
+ * number of bus transactions an API call costs.
+ *
+ * Example:
+ * @code
+ * mcal::sim::reset();
+ * board::LD_Green::set();
+ * assert(mcal::sim::bus::writes() == 1 && mcal::sim::bus::reads() == 0);
+ * @endcode
+ *
+ * Device specific behaviour (ready flags, free running counters, ...)
+ * is provided by models which hook into register reads and writes.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace mcal::sim
+{
+	/**
+	 * @brief Kind of a bus transaction.
+	 */
+	enum class access_kind : std::uint8_t
+	{
+		read,  //!< Register load
+		write, //!< Register store
+	};
+
+	/**
+	 * @brief One recorded bus transaction.
+	 */
+	struct access
+	{
+		std::uint32_t address;						//!< Device address of the register
+		std::uint32_t value;						//!< Value loaded or stored
+		access_kind kind;							//!< Load or store
+		std::uint64_t tick;							//!< Sequence number of the transaction
+		std::chrono::steady_clock::time_point time; //!< Host time of the transaction
+	};
+
+	/**
+	 * @brief Map a device address range onto simulated memory.
+	 *
+	 * Memory is allocated on first use and zero initialized. The same
+	 * device address always maps to the same host storage, regardless of
+	 * the size of the requested window.
+	 *
+	 * @param address Device address
+	 * @param size    Size of the accessed window in bytes
+	 * @return Host pointer backing @p address
+	 */
+	void *map(std::uint32_t address, std::size_t size) noexcept;
+
+	/**
+	 * @brief Direct access to a simulated register, bypassing the bus.
+	 *
+	 * Intended for test setup and inspection; not counted.
+	 *
+	 * @param address Device address of the register
+	 * @return Reference to the register storage
+	 */
+	std::uint32_t &at(std::uint32_t address) noexcept;
+
+	/**
+	 * @brief Reset the simulation.
+	 *
+	 * Zeroes all simulated memory, clears hooks and bus statistics, then
+	 * installs all registered device models again. Host pointers returned
+	 * by map() stay valid.
+	 */
+	void reset() noexcept;
+
+	/**
+	 * @brief Register a device model.
+	 *
+	 * @p install is called on every reset() and may set reset values and
+	 * install bus hooks. Models are typically registered from a static
+	 * initializer of the device support code.
+	 *
+	 * @param install Model installation function
+	 * @return Always true, for use in static initializers
+	 */
+	bool add_model(void (*install)()) noexcept;
+
+	/**
+	 * @brief Simulated bus with access counters and hooks.
+	 */
+	struct bus
+	{
+		/**
+		 * @brief Hook called on a register access.
+		 *
+		 * Receives the device address and a reference to the register value:
+		 * for reads before the value is returned, for writes after it was stored.
+		 */
+		using hook = std::function<void(std::uint32_t address, std::uint32_t &value)>;
+
+		/**
+		 * @brief Load a register through the simulated bus.
+		 */
+		static std::uint32_t load(const volatile std::uint32_t &reg) noexcept;
+
+		/**
+		 * @brief Store a register through the simulated bus.
+		 */
+		static void store(volatile std::uint32_t &reg, std::uint32_t value) noexcept;
+
+		/**
+		 * @brief Install a hook for loads of one register.
+		 */
+		static void on_read(std::uint32_t address, hook callback);
+
+		/**
+		 * @brief Install a hook for stores of one register.
+		 */
+		static void on_write(std::uint32_t address, hook callback);
+
+		/**
+		 * @brief Number of loads since the last clear().
+		 */
+		[[nodiscard]]
+		static std::size_t reads() noexcept;
+
+		/**
+		 * @brief Number of loads of one register since the last clear().
+		 */
+		[[nodiscard]]
+		static std::size_t reads(std::uint32_t address) noexcept;
+
+		/**
+		 * @brief Number of stores since the last clear().
+		 */
+		[[nodiscard]]
+		static std::size_t writes() noexcept;
+
+		/**
+		 * @brief Number of stores to one register since the last clear().
+		 */
+		[[nodiscard]]
+		static std::size_t writes(std::uint32_t address) noexcept;
+
+		/**
+		 * @brief All transactions since the last clear(), in order.
+		 */
+		[[nodiscard]]
+		static const std::vector<access> &log() noexcept;
+
+		/**
+		 * @brief Reset counters and the transaction log.
+		 *
+		 * Simulated memory and hooks are kept.
+		 */
+		static void clear() noexcept;
+	};
+
+} // namespace mcal::sim
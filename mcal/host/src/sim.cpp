@@ -0,0 +1,229 @@
+/**
+ * @file sim.cpp
+ * @brief Simulated peripheral backend for host builds of the MCAL.
+ */
+
+#include "sim.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace mcal::sim
+{
+	namespace
+	{
+		/**
+		 * @brief Simulated memory is allocated in 64 KiB blocks.
+		 *
+		 * No STM32 peripheral register block crosses a 64 KiB boundary, so
+		 * every peripheral struct maps onto contiguous host memory.
+		 */
+		constexpr std::uint32_t block_bits = 16;
+		constexpr std::uint32_t block_size = 1u << block_bits;
+
+		/**
+		 * @brief Access counters of one register.
+		 */
+		struct counters
+		{
+			std::size_t reads{};  //!< Number of loads
+			std::size_t writes{}; //!< Number of stores
+		};
+
+		/**
+		 * @brief Complete simulation state.
+		 */
+		struct state
+		{
+			std::map<std::uint32_t, std::unique_ptr<std::uint32_t[]>> blocks; //!< Memory, keyed by address >> 16
+			std::unordered_map<std::uint32_t, bus::hook> read_hooks;		  //!< Hooks per register
+			std::unordered_map<std::uint32_t, bus::hook> write_hooks;		  //!< Hooks per register
+			std::unordered_map<std::uint32_t, counters> per_register;		  //!< Counters per register
+			std::vector<access> log;										  //!< Transaction log
+			counters total;													  //!< Counters of all registers
+			std::uint64_t tick{};											  //!< Transaction sequence number
+			std::vector<void (*)()> models;									  //!< Registered device models
+		};
+
+		/**
+		 * @brief Simulation state, constructed on first use.
+		 */
+		state &sim() noexcept
+		{
+			static state s;
+			return s;
+		}
+
+		/**
+		 * @brief Host storage of a memory block, allocated on first use.
+		 */
+		std::uint32_t *block(std::uint32_t index) noexcept
+		{
+			auto &storage = sim().blocks[index];
+			if (!storage)
+			{
+				storage = std::make_unique<std::uint32_t[]>(block_size / sizeof(std::uint32_t));
+			}
+			return storage.get();
+		}
+
+		/**
+		 * @brief Translate a host pointer back to its device address.
+		 *
+		 * @return Device address, or 0 for memory outside the simulated map
+		 */
+		std::uint32_t device_address(const volatile std::uint32_t *reg) noexcept
+		{
+			const auto host = reinterpret_cast<std::uintptr_t>(reg);
+			for (const auto &[index, storage] : sim().blocks)
+			{
+				const auto base = reinterpret_cast<std::uintptr_t>(storage.get());
+				if (host >= base && host < base + block_size)
+				{
+					return (index << block_bits) + static_cast<std::uint32_t>(host - base);
+				}
+			}
+			return 0;
+		}
+
+		/**
+		 * @brief Count and log one transaction.
+		 */
+		void record(std::uint32_t address, std::uint32_t value, access_kind kind) noexcept
+		{
+			auto &s = sim();
+			auto &reg = s.per_register[address];
+			if (kind == access_kind::read)
+			{
+				++s.total.reads;
+				++reg.reads;
+			}
+			else
+			{
+				++s.total.writes;
+				++reg.writes;
+			}
+			s.log.push_back({address, value, kind, s.tick++, std::chrono::steady_clock::now()});
+		}
+	} // namespace
+
+	void *map(std::uint32_t address, std::size_t size) noexcept
+	{
+		const std::uint32_t offset = address & (block_size - 1);
+		if (offset + size > block_size)
+		{
+			std::fprintf(stderr, "sim: window 0x%08lx + %zu crosses a 64 KiB boundary\n",
+						 static_cast<unsigned long>(address), size);
+			std::abort();
+		}
+		return reinterpret_cast<std::uint8_t *>(block(address >> block_bits)) + offset;
+	}
+
+	std::uint32_t &at(std::uint32_t address) noexcept
+	{
+		return *static_cast<std::uint32_t *>(map(address, sizeof(std::uint32_t)));
+	}
+
+	void reset() noexcept
+	{
+		auto &s = sim();
+		for (auto &[index, storage] : s.blocks)
+		{
+			std::fill_n(storage.get(), block_size / sizeof(std::uint32_t), 0u);
+		}
+		s.read_hooks.clear();
+		s.write_hooks.clear();
+		bus::clear();
+		for (auto install : s.models)
+		{
+			install();
+		}
+	}
+
+	bool add_model(void (*install)()) noexcept
+	{
+		sim().models.push_back(install);
+		install();
+		return true;
+	}
+
+	std::uint32_t bus::load(const volatile std::uint32_t &reg) noexcept
+	{
+		auto &storage = const_cast<std::uint32_t &>(reg);
+		const std::uint32_t address = device_address(&reg);
+
+		if (auto hook = sim().read_hooks.find(address); address != 0 && hook != sim().read_hooks.end())
+		{
+			hook->second(address, storage);
+		}
+
+		const std::uint32_t value = reg;
+		record(address, value, access_kind::read);
+		return value;
+	}
+
+	void bus::store(volatile std::uint32_t &reg, std::uint32_t value) noexcept
+	{
+		auto &storage = const_cast<std::uint32_t &>(reg);
+		const std::uint32_t address = device_address(&reg);
+
+		reg = value;
+		record(address, value, access_kind::write);
+
+		if (auto hook = sim().write_hooks.find(address); address != 0 && hook != sim().write_hooks.end())
+		{
+			hook->second(address, storage);
+		}
+	}
+
+	void bus::on_read(std::uint32_t address, hook callback)
+	{
+		sim().read_hooks[address] = std::move(callback);
+	}
+
+	void bus::on_write(std::uint32_t address, hook callback)
+	{
+		sim().write_hooks[address] = std::move(callback);
+	}
+
+	std::size_t bus::reads() noexcept
+	{
+		return sim().total.reads;
+	}
+
+	std::size_t bus::reads(std::uint32_t address) noexcept
+	{
+		const auto reg = sim().per_register.find(address);
+		return reg == sim().per_register.end() ? 0 : reg->second.reads;
+	}
+
+	std::size_t bus::writes() noexcept
+	{
+		return sim().total.writes;
+	}
+
+	std::size_t bus::writes(std::uint32_t address) noexcept
+	{
+		const auto reg = sim().per_register.find(address);
+		return reg == sim().per_register.end() ? 0 : reg->second.writes;
+	}
+
+	const std::vector<access> &bus::log() noexcept
+	{
+		return sim().log;
+	}
+
+	void bus::clear() noexcept
+	{
+		auto &s = sim();
+		s.per_register.clear();
+		s.log.clear();
+		s.total = {};
+	}
+
+} // namespace mcal::sim
@@ -0,0 +1,26 @@
+/**
+ * @file clock.hpp
+ * @brief Concept definition for monotonic time sources.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+#include "units.hpp"
+
+namespace mcal::concepts
+{
+	/**
+	 * @brief Concept for monotonic clocks.
+	 *
+	 * Requires a static now() returning the time since start with µs
+	 * resolution in 64 bit, which never wraps in practice.
+	 */
+	template <typename T>
+	concept Clock = requires {
+		{ T::now() } -> std::same_as<utils::quantity::us64_t>;
+	};
+
+} // namespace mcal::concepts
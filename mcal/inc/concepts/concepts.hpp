@@ -4,6 +4,7 @@
  *
  */
 #pragma once
+#include "clock.hpp"
 #include "delay.hpp"
 #include "gpio.hpp"
 /**
@@ -11,7 +11,7 @@ namespace mcal::concepts
 	/**
 	 * @brief GPIO pin modes.
 	 *
-	 * @todo expand with more modes (alternate function, analog, pull-up, pull-down)
+	 * @todo expand with more modes (alternate function, analog)
 	 *
 	 */
 	enum class GpioPinMode
@@ -20,14 +20,46 @@ namespace mcal::concepts
 		Output, //!< Output mode
 	};
 
+	/**
+	 * @brief GPIO output driver types.
+	 *
+	 */
+	enum class GpioOutputType
+	{
+		PushPull,  //!< Push-pull output
+		OpenDrain, //!< Open-drain output
+	};
+
+	/**
+	 * @brief GPIO output slew rates.
+	 *
+	 */
+	enum class GpioSpeed
+	{
+		Low,	  //!< Low speed
+		Medium,	  //!< Medium speed
+		High,	  //!< High speed
+		VeryHigh, //!< Very high speed
+	};
+
+	/**
+	 * @brief GPIO pull resistor configuration.
+	 *
+	 */
+	enum class GpioPull
+	{
+		None, //!< No pull resistor
+		Up,	  //!< Pull-up resistor
+		Down, //!< Pull-down resistor
+	};
+
 	/**
 	 * @brief GPIO port concept.
 	 *
 	 * This concept defines the required interface for a GPIO port
 	 * implementation. A GPIO port must provide methods to enable/disable
-	 * the port clock, set pin modes, and read/write pin states.
-	 *
-	 * @todo A toggle function is needed as well.
+	 * the port clock, set pin modes, and read/write/toggle pin states.
+	 * The masked variants operate on several pins of the port at once.
 	 *
 	 */
 	template <typename T>
@@ -37,6 +69,11 @@ namespace mcal::concepts
 		{ T::template setMode<5, GpioPinMode::Output>() } -> std::same_as<void>;
 		{ T::template writeHigh<5>() } -> std::same_as<void>;
 		{ T::template writeLow<5>() } -> std::same_as<void>;
+		{ T::template toggle<5>() } -> std::same_as<void>;
 		{ T::template read<5>() } -> std::same_as<bool>;
+		{ T::template writeHighMask<0x00F0>() } -> std::same_as<void>;
+		{ T::template writeLowMask<0x00F0>() } -> std::same_as<void>;
+		{ T::template writeMask<0x00F0>(uint16_t{}) } -> std::same_as<void>;
+		{ T::template readMask<0x00F0>() } -> std::same_as<uint16_t>;
 	};
 } // namespace mcal::concepts
@@ -0,0 +1,172 @@
+/**
+ * @file deadline.hpp
+ * @brief Non-blocking deadlines and timeouts on a monotonic clock.
+ *
+ * Meant for cooperative super-loops that poll many timeouts:
+ * @code
+ * board::Timebase::init();
+ * mcal::Deadline<board::Timebase> blink{500 * utils::unit::ms};
+ * mcal::Timeout<board::Timebase> rx{20 * utils::unit::ms};
+ * while (true)
+ * {
+ *     if (blink.expired())
+ *     {
+ *         board::LD_Green::toggle();
+ *         blink.advance(500 * utils::unit::ms); // drift-free period
+ *     }
+ *     if (uart_received())
+ *     {
+ *         rx.restart();
+ *     }
+ *     else if (rx.expired())
+ *     {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+#pragma once
+
+#include "concepts/clock.hpp"
+#include "units.hpp"
+
+namespace mcal
+{
+	/**
+	 * @brief Point in time after which something is due.
+	 *
+	 * @tparam Clock Monotonic time source
+	 */
+	template <concepts::Clock Clock>
+	class Deadline
+	{
+	  public:
+		/**
+		 * @brief Deadline relative to now.
+		 *
+		 * @param timeout Time from now
+		 */
+		explicit Deadline(utils::quantity::us_t timeout) noexcept : expiry{Clock::now() + timeout}
+		{
+		}
+
+		/**
+		 * @brief Deadline at an absolute time.
+		 *
+		 * @param time Time since clock start
+		 */
+		[[nodiscard]]
+		static Deadline absolute(utils::quantity::us64_t time) noexcept
+		{
+			return Deadline{time, absolute_time{}};
+		}
+
+		/**
+		 * @brief Check whether the deadline has passed.
+		 */
+		[[nodiscard]]
+		bool expired() const noexcept
+		{
+			return Clock::now() >= expiry;
+		}
+
+		/**
+		 * @brief Time left until the deadline, zero once expired.
+		 */
+		[[nodiscard]]
+		utils::quantity::us64_t remaining() const noexcept
+		{
+			const utils::quantity::us64_t now = Clock::now();
+			return now < expiry ? expiry - now : utils::quantity::us64_t{};
+		}
+
+		/**
+		 * @brief Absolute time of the deadline.
+		 */
+		[[nodiscard]]
+		utils::quantity::us64_t at() const noexcept
+		{
+			return expiry;
+		}
+
+		/**
+		 * @brief Move the deadline by a period from its previous expiry.
+		 *
+		 * Keeps periodic work free of drift. If the loop fell behind by more
+		 * than one period, the deadline restarts from now instead of
+		 * expiring repeatedly.
+		 *
+		 * @param period Period length
+		 */
+		void advance(utils::quantity::us_t period) noexcept
+		{
+			expiry = expiry + period;
+			const utils::quantity::us64_t now = Clock::now();
+			if (expiry <= now)
+			{
+				expiry = now + period;
+			}
+		}
+
+	  private:
+		struct absolute_time
+		{
+		};
+
+		Deadline(utils::quantity::us64_t time, absolute_time) noexcept : expiry{time}
+		{
+		}
+
+		utils::quantity::us64_t expiry; //!< Absolute expiry time
+	};
+
+	/**
+	 * @brief Restartable timeout of a fixed length.
+	 *
+	 * @tparam Clock Monotonic time source
+	 */
+	template <concepts::Clock Clock>
+	class Timeout
+	{
+	  public:
+		/**
+		 * @brief Start a timeout.
+		 *
+		 * @param length Timeout length
+		 */
+		explicit Timeout(utils::quantity::us_t length) noexcept : length{length}, deadline{length}
+		{
+		}
+
+		/**
+		 * @brief Start the timeout again from now, e.g. on activity.
+		 */
+		void restart() noexcept
+		{
+			deadline = Deadline<Clock>{length};
+		}
+
+		/**
+		 * @brief Check whether the timeout has elapsed since the last (re)start.
+		 */
+		[[nodiscard]]
+		bool expired() const noexcept
+		{
+			return deadline.expired();
+		}
+
+		/**
+		 * @brief Time left, zero once expired.
+		 */
+		[[nodiscard]]
+		utils::quantity::us64_t remaining() const noexcept
+		{
+			return deadline.remaining();
+		}
+
+	  private:
+		utils::quantity::us_t length; //!< Timeout length
+		Deadline<Clock> deadline;	  //!< Current expiry
+	};
+
+} // namespace mcal
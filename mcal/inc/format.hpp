@@ -0,0 +1,658 @@
+/**
+ * @file format.hpp
+ * @brief Compile-time checked text formatting without heap and printf().
+ *
+ * A small subset of std::format. The format string is a template argument,
+ * so it is parsed and checked against the argument types at compile time;
+ * at runtime only the literal parts are copied and the arguments converted.
+ * Quantities are printed with their unit symbol.
+ *
+ * @code
+ * mcal::format::print<sink, "SysClk: {:>9}\n">(clock::hclk()); // "SysClk: 180000000 Hz"
+ * @endcode
+ *
+ * Field syntax: `{}` or `{:[[fill]align][0][width][type]}`
+ * - align: `<` left, `>` right, `^` centre (numbers default to right, text to left),
+ * - `0`: pad numbers with zeros after the sign,
+ * - type: `d` decimal, `x`/`X` hex, `b` binary, `c` character, `s` text.
+ *
+ * `{{` and `}}` print a single brace. Arguments are taken in order, a
+ * quantity's width applies to the number without the unit.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "units.hpp"
+
+namespace mcal::format
+{
+	/**
+	 * @brief Longest string argument printed, longer strings are truncated.
+	 */
+	inline constexpr std::size_t max_string = 64;
+
+	/**
+	 * @brief Format string usable as template argument.
+	 *
+	 * @tparam N Size of the string literal including the terminator
+	 */
+	template <std::size_t N>
+	struct string
+	{
+		constexpr string(const char (&text)[N]) noexcept
+		{
+			for (std::size_t i = 0; i < N; ++i)
+			{
+				value[i] = text[i];
+			}
+		}
+
+		/**
+		 * @brief Format string without the terminator.
+		 */
+		[[nodiscard]]
+		constexpr std::string_view view() const noexcept
+		{
+			return {value, N - 1};
+		}
+
+		char value[N]{}; //!< Characters including the terminator
+	};
+
+	/**
+	 * @brief Parsed field specification.
+	 */
+	struct spec
+	{
+		char fill = ' ';		//!< Padding character
+		char align = '\0';		//!< '<', '>', '^' or '\0' for the default of the type
+		bool zero = false;		//!< Pad numbers with zeros after the sign
+		std::uint8_t width = 0; //!< Minimum width
+		char type = '\0';		//!< Presentation type or '\0'
+	};
+
+	/**
+	 * @brief Format string parse result.
+	 */
+	enum class error : std::uint8_t
+	{
+		none,			 //!< Valid format string
+		unmatched_brace, //!< Single '{' or '}'
+		bad_spec,		 //!< Invalid field specification
+	};
+
+	/**
+	 * @brief Literal text or argument field of a format string.
+	 */
+	struct segment
+	{
+		std::size_t begin = 0;	//!< Offset of the literal text
+		std::size_t length = 0; //!< Length of the literal text, 0 for a field
+		std::size_t arg = 0;	//!< Argument index of a field
+		spec field{};			//!< Specification of a field
+
+		[[nodiscard]]
+		constexpr bool is_field() const noexcept
+		{
+			return length == 0;
+		}
+	};
+
+	/**
+	 * @brief Format string split into segments.
+	 *
+	 * @tparam N Maximum number of segments
+	 */
+	template <std::size_t N>
+	struct layout
+	{
+		std::array<segment, N> segments{}; //!< Segments in output order
+		std::size_t count = 0;			   //!< Number of segments
+		std::size_t fields = 0;			   //!< Number of argument fields
+		error status = error::none;		   //!< Parse result
+	};
+
+	/**
+	 * @brief Split a format string into literal text and fields.
+	 */
+	template <string Format>
+	consteval auto parse() noexcept
+	{
+		constexpr std::string_view text = Format.view();
+		layout<text.size() + 1> result{};
+
+		std::size_t literal = 0;
+		const auto flush = [&](std::size_t end) {
+			if (end > literal)
+			{
+				result.segments[result.count++] = {literal, end - literal};
+			}
+		};
+		const auto is_align = [](char c) { return c == '<' || c == '>' || c == '^'; };
+
+		std::size_t i = 0;
+		while (i < text.size())
+		{
+			const char c = text[i];
+			const bool doubled = (i + 1 < text.size()) && (text[i + 1] == c);
+			if ((c == '{' || c == '}') && doubled)
+			{
+				// Keep one brace as literal text
+				flush(i + 1);
+				i += 2;
+				literal = i;
+				continue;
+			}
+			if (c == '}')
+			{
+				result.status = error::unmatched_brace;
+				return result;
+			}
+			if (c != '{')
+			{
+				++i;
+				continue;
+			}
+
+			flush(i);
+			++i;
+			spec field{};
+			if (i < text.size() && text[i] == ':')
+			{
+				++i;
+				if (i + 1 < text.size() && is_align(text[i + 1]) && text[i] != '{' && text[i] != '}')
+				{
+					field.fill = text[i];
+					field.align = text[i + 1];
+					i += 2;
+				}
+				else if (i < text.size() && is_align(text[i]))
+				{
+					field.align = text[i++];
+				}
+				if (i < text.size() && text[i] == '0')
+				{
+					field.zero = true;
+					++i;
+				}
+				unsigned width = 0;
+				while (i < text.size() && text[i] >= '0' && text[i] <= '9')
+				{
+					width = width * 10 + static_cast<unsigned>(text[i++] - '0');
+					if (width > 255)
+					{
+						result.status = error::bad_spec;
+						return result;
+					}
+				}
+				field.width = static_cast<std::uint8_t>(width);
+				if (i < text.size() && std::string_view{"dxXbcs"}.find(text[i]) != std::string_view::npos)
+				{
+					field.type = text[i++];
+				}
+			}
+			if (i >= text.size())
+			{
+				result.status = error::unmatched_brace;
+				return result;
+			}
+			if (text[i] != '}')
+			{
+				result.status = error::bad_spec;
+				return result;
+			}
+			result.segments[result.count++] = {i, 0, result.fields++, field};
+			literal = ++i;
+		}
+		flush(text.size());
+		return result;
+	}
+
+	namespace detail
+	{
+		/**
+		 * @brief Quantity with a numerical value and a unit.
+		 */
+		template <typename T>
+		concept quantity = requires(const T &value) { value.numerical_value_in(T::unit); };
+
+		/**
+		 * @brief Null terminated or sized text.
+		 */
+		template <typename T>
+		concept text = std::is_same_v<T, const char *> || std::is_same_v<T, char *> ||
+					   std::is_same_v<T, std::string_view>;
+
+		/**
+		 * @brief Integer printed as a number by default.
+		 */
+		template <typename T>
+		concept number = (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>) ||
+						 std::is_enum_v<T>;
+
+		/**
+		 * @brief Argument types supported by format_to().
+		 */
+		template <typename T>
+		concept formattable = number<T> || text<T> || quantity<T> || std::is_same_v<T, bool> ||
+							  std::is_same_v<T, char>;
+
+		/**
+		 * @brief Check whether a presentation type fits an argument type.
+		 */
+		template <typename T>
+		constexpr bool accepts(char type) noexcept
+		{
+			const bool numeric = type == '\0' || type == 'd' || type == 'x' || type == 'X' || type == 'b';
+			if constexpr (std::is_same_v<T, bool> || text<T>)
+				return type == '\0' || type == 's';
+			else if constexpr (std::is_same_v<T, char> || std::is_integral_v<T>)
+				return numeric || type == 'c';
+			else
+				return numeric;
+		}
+
+		/**
+		 * @brief Number base of a presentation type.
+		 */
+		constexpr unsigned base(char type) noexcept
+		{
+			return (type == 'x' || type == 'X') ? 16 : (type == 'b') ? 2 : 10;
+		}
+
+		/**
+		 * @brief Integer type of a number argument, quantities use their representation.
+		 */
+		template <typename T>
+		struct integer
+		{
+			using type = T;
+		};
+
+		template <typename T>
+			requires std::is_enum_v<T>
+		struct integer<T>
+		{
+			using type = std::underlying_type_t<T>;
+		};
+
+		template <quantity T>
+		struct integer<T>
+		{
+			using type = std::remove_cvref_t<decltype(std::declval<const T &>().numerical_value_in(T::unit))>;
+		};
+
+		/**
+		 * @brief Largest number of characters of an integer, including the sign.
+		 */
+		template <typename T>
+		constexpr std::size_t integer_size(char type) noexcept
+		{
+			const std::size_t bits = sizeof(T) * 8;
+			const std::size_t sign = std::is_signed_v<T> ? 1 : 0;
+			switch (base(type))
+			{
+			case 2:
+				return bits + sign;
+			case 16:
+				return bits / 4 + sign;
+			default:
+				return (bits * 30103 + 99'999) / 100'000 + sign; // digits = bits * log10(2), rounded up
+			}
+		}
+
+		/**
+		 * @brief Printed symbol of a quantity's unit.
+		 */
+		template <quantity T>
+		constexpr std::string_view symbol() noexcept
+		{
+			constexpr std::string_view name = utils::unit::symbol<T::unit>;
+			static_assert(!name.empty(), "No symbol for the unit of this quantity, specialise utils::unit::symbol");
+			return name;
+		}
+
+		/**
+		 * @brief Largest number of characters printed for one argument.
+		 */
+		template <typename T>
+		constexpr std::size_t field_size(spec field) noexcept
+		{
+			std::size_t size = 0;
+			if constexpr (std::is_same_v<T, bool>)
+				size = 5;
+			else if constexpr (text<T>)
+				size = max_string;
+			else if constexpr (std::is_same_v<T, char>)
+				size = (field.type == '\0' || field.type == 'c') ? 1 : integer_size<char>(field.type);
+			else if (field.type == 'c')
+				size = 1;
+			else
+				size = integer_size<typename integer<T>::type>(field.type);
+
+			size = size < field.width ? field.width : size;
+			if constexpr (quantity<T>)
+			{
+				size += 1 + symbol<T>().size();
+			}
+			return size;
+		}
+
+		/**
+		 * @brief Write the digits of an unsigned integer.
+		 *
+		 * Shared by all fields of one base and width.
+		 *
+		 * @return Number of digits written
+		 */
+		template <unsigned Base, bool Upper, typename U>
+		[[gnu::noinline]]
+		std::size_t digits(char *out, U value) noexcept
+		{
+			constexpr const char *symbols = Upper ? "0123456789ABCDEF" : "0123456789abcdef";
+			char reversed[sizeof(U) * 8];
+			std::size_t count = 0;
+			do
+			{
+				reversed[count++] = symbols[value % Base];
+				value /= Base;
+			} while (value != 0);
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				out[i] = reversed[count - 1 - i];
+			}
+			return count;
+		}
+
+		/**
+		 * @brief Copy text with padding.
+		 *
+		 * @param out    Output position
+		 * @param value  Text to print
+		 * @param field  Field specification
+		 * @param align  Default alignment of the argument type
+		 * @param prefix Number of sign characters placed before zero padding
+		 * @return Output position behind the field
+		 */
+		[[gnu::noinline]]
+		inline char *pad(char *out, std::string_view value, spec field, char align, std::size_t prefix) noexcept
+		{
+			char fill = field.fill;
+			if (field.zero)
+			{
+				fill = '0';
+				align = '=';
+			}
+			else if (field.align != '\0')
+			{
+				align = field.align;
+			}
+
+			const std::size_t gap = value.size() < field.width ? field.width - value.size() : 0;
+			const std::size_t before = (align == '<') ? 0 : (align == '^') ? gap / 2 : gap;
+
+			if (align == '=')
+			{
+				std::memcpy(out, value.data(), prefix);
+				out += prefix;
+				value.remove_prefix(prefix);
+			}
+			std::memset(out, fill, before);
+			out += before;
+			std::memcpy(out, value.data(), value.size());
+			out += value.size();
+			std::memset(out, fill, gap - before);
+			return out + (gap - before);
+		}
+
+		/**
+		 * @brief Print text.
+		 */
+		template <spec Field>
+		char *put_text(char *out, std::string_view value) noexcept
+		{
+			if (value.size() > max_string)
+			{
+				value = value.substr(0, max_string);
+			}
+			if constexpr (Field.width == 0)
+			{
+				std::memcpy(out, value.data(), value.size());
+				return out + value.size();
+			}
+			else
+			{
+				return pad(out, value, Field, '<', 0);
+			}
+		}
+
+		/**
+		 * @brief Print an integer.
+		 */
+		template <spec Field, typename T>
+		char *put_integer(char *out, T value) noexcept
+		{
+			if constexpr (Field.type == 'c')
+			{
+				const char c = static_cast<char>(value);
+				return put_text<Field>(out, {&c, 1});
+			}
+			else
+			{
+				// Divide in 32 bit unless the type needs 64 bit
+				using U = std::conditional_t<(sizeof(T) > sizeof(std::uint32_t)), std::uint64_t, std::uint32_t>;
+				U magnitude = static_cast<U>(value);
+				char number[1 + sizeof(U) * 8];
+				std::size_t length = 0;
+				if constexpr (std::is_signed_v<T>)
+				{
+					if (value < 0)
+					{
+						number[length++] = '-';
+						magnitude = U{0} - magnitude;
+					}
+				}
+				length += digits<base(Field.type), Field.type == 'X'>(number + length, magnitude);
+				if constexpr (Field.width == 0)
+				{
+					std::memcpy(out, number, length);
+					return out + length;
+				}
+				else
+				{
+					return pad(out, {number, length}, Field, '>', number[0] == '-' ? 1 : 0);
+				}
+			}
+		}
+
+		/**
+		 * @brief Print one argument.
+		 */
+		template <spec Field, typename T>
+		char *put(char *out, const T &value) noexcept
+		{
+			using U = std::decay_t<T>;
+			if constexpr (std::is_same_v<U, bool>)
+			{
+				return put_text<Field>(out, value ? "true" : "false");
+			}
+			else if constexpr (std::is_same_v<U, std::string_view>)
+			{
+				return put_text<Field>(out, value);
+			}
+			else if constexpr (text<U>)
+			{
+				const char *string = value;
+				return put_text<Field>(out, string != nullptr ? std::string_view{string} : "(null)");
+			}
+			else if constexpr (std::is_same_v<U, char> && (Field.type == '\0' || Field.type == 'c'))
+			{
+				return put_text<Field>(out, {&value, 1});
+			}
+			else if constexpr (quantity<U>)
+			{
+				constexpr std::string_view name = symbol<U>();
+				out = put_integer<Field>(out, value.numerical_value_in(U::unit));
+				*out++ = ' ';
+				std::memcpy(out, name.data(), name.size());
+				return out + name.size();
+			}
+			else if constexpr (std::is_enum_v<U>)
+			{
+				return put_integer<Field>(out, static_cast<std::underlying_type_t<U>>(value));
+			}
+			else
+			{
+				return put_integer<Field>(out, value);
+			}
+		}
+
+		/**
+		 * @brief Parsed format string, shared by all calls with the same format.
+		 */
+		template <string Format>
+		inline constexpr auto parsed = parse<Format>();
+
+		/**
+		 * @brief Check the presentation type of a field against its argument.
+		 */
+		template <segment S, typename... Args>
+		constexpr bool segment_accepts() noexcept
+		{
+			if constexpr (S.is_field())
+				return accepts<std::tuple_element_t<S.arg, std::tuple<Args...>>>(S.field.type);
+			else
+				return true;
+		}
+
+		/**
+		 * @brief Check the presentation types of all fields.
+		 */
+		template <string Format, typename... Args>
+		constexpr bool types_match() noexcept
+		{
+			if constexpr (parsed<Format>.status != error::none || parsed<Format>.fields != sizeof...(Args) ||
+						  !(formattable<Args> && ...))
+			{
+				return true; // reported separately
+			}
+			else
+			{
+				return []<std::size_t... I>(std::index_sequence<I...>) {
+					return (segment_accepts<parsed<Format>.segments[I], Args...>() && ...);
+				}(std::make_index_sequence<parsed<Format>.count>{});
+			}
+		}
+
+		/**
+		 * @brief Compile-time checks of a format string against the argument types.
+		 */
+		template <string Format, typename... Args>
+		struct checked
+		{
+			static_assert(parsed<Format>.status != error::unmatched_brace, "Unmatched '{' or '}' in format string");
+			static_assert(parsed<Format>.status != error::bad_spec,
+						  "Invalid format field, expected {:[[fill]align][0][width][type]}");
+			static_assert((formattable<Args> && ...), "Unsupported format argument type");
+			static_assert(parsed<Format>.fields == sizeof...(Args),
+						  "Number of format fields does not match the number of arguments");
+			static_assert(types_match<Format, Args...>(), "Format type does not match the argument type");
+
+			static constexpr bool ok = parsed<Format>.status == error::none &&
+									   parsed<Format>.fields == sizeof...(Args) && (formattable<Args> && ...) &&
+									   types_match<Format, Args...>(); //!< All checks passed
+		};
+
+		/**
+		 * @brief Largest number of characters of one segment.
+		 */
+		template <segment S, typename... Args>
+		constexpr std::size_t segment_size() noexcept
+		{
+			if constexpr (S.is_field())
+				return field_size<std::tuple_element_t<S.arg, std::tuple<Args...>>>(S.field);
+			else
+				return S.length;
+		}
+
+		/**
+		 * @brief Print one segment.
+		 */
+		template <string Format, segment S, typename Tuple>
+		char *put_segment(char *out, const Tuple &values) noexcept
+		{
+			if constexpr (S.is_field())
+			{
+				return put<S.field>(out, std::get<S.arg>(values));
+			}
+			else
+			{
+				std::memcpy(out, Format.value + S.begin, S.length);
+				return out + S.length;
+			}
+		}
+
+	} // namespace detail
+
+	/**
+	 * @brief Largest number of characters format_to() writes.
+	 */
+	template <string Format, typename... Args>
+	inline constexpr std::size_t max_size = []<std::size_t... I>(std::index_sequence<I...>) {
+		if constexpr (detail::checked<Format, std::decay_t<Args>...>::ok)
+			return (std::size_t{0} + ... + detail::segment_size<detail::parsed<Format>.segments[I], std::decay_t<Args>...>());
+		else
+			return std::size_t{0};
+	}(std::make_index_sequence<detail::parsed<Format>.count>{});
+
+	/**
+	 * @brief Format into a buffer.
+	 *
+	 * @tparam Format Format string
+	 * @param out     Buffer of at least max_size<Format, Args...> characters
+	 * @param args    Arguments
+	 * @return Position behind the last character, no terminator is written
+	 */
+	template <string Format, typename... Args>
+	char *format_to(char *out, const Args &...args) noexcept
+	{
+		if constexpr (detail::checked<Format, std::decay_t<Args>...>::ok)
+		{
+			const std::tuple<const Args &...> values{args...};
+			[&]<std::size_t... I>(std::index_sequence<I...>) {
+				((out = detail::put_segment<Format, detail::parsed<Format>.segments[I]>(out, values)), ...);
+			}(std::make_index_sequence<detail::parsed<Format>.count>{});
+		}
+		return out;
+	}
+
+	/**
+	 * @brief Format and hand the text to a sink in one write.
+	 *
+	 * The text is built on the stack, the buffer size is known at compile
+	 * time (see max_size).
+	 *
+	 * @tparam Sink   Output with a static write(std::span<const std::uint8_t>)
+	 * @tparam Format Format string
+	 * @param args    Arguments
+	 */
+	template <typename Sink, string Format, typename... Args>
+	void print(const Args &...args) noexcept
+	{
+		std::array<char, max_size<Format, Args...>> buffer;
+		const char *end = format_to<Format>(buffer.data(), args...);
+		Sink::write(std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t *>(buffer.data()),
+												  static_cast<std::size_t>(end - buffer.data())));
+	}
+
+} // namespace mcal::format
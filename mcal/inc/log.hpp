@@ -0,0 +1,192 @@
+/**
+ * @file log.hpp
+ * @brief Tokenised binary logging.
+ *
+ * MCAL_LOG_TO() never formats on the target. The format string is placed
+ * into the non-loaded ELF section .mcal_log and only its address within
+ * that section (the token) is sent, followed by the raw argument bytes.
+ * tools/logdecode.py reads the format strings back from the ELF file and
+ * prints the decoded text on the host.
+ *
+ * Frame layout, all integers little endian:
+ * @code
+ * varint length | varint token | argument bytes ...
+ * @endcode
+ * Arguments are encoded by their type (ARM EABI sizes):
+ * - integers, enums and bool up to 32 bit: 4 bytes, 64 bit integers: 8 bytes,
+ * - floating point: 8 bytes (double, as after printf promotion),
+ * - C strings: varint length followed by at most max_string bytes,
+ * - other pointers: 4 bytes.
+ *
+ * The format string is checked against the arguments like a printf()
+ * call, without referencing printf().
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace mcal::log
+{
+	/**
+	 * @brief Longest string argument sent, longer strings are truncated.
+	 */
+	inline constexpr std::size_t max_string = 64;
+
+	/**
+	 * @brief Number of bytes of an unsigned LEB128 varint.
+	 */
+	constexpr std::size_t varint_size(std::uint32_t value) noexcept
+	{
+		std::size_t size = 1;
+		while (value >= 0x80u)
+		{
+			value >>= 7;
+			++size;
+		}
+		return size;
+	}
+
+	/**
+	 * @brief Write an unsigned LEB128 varint.
+	 *
+	 * @return Number of bytes written
+	 */
+	constexpr std::size_t put_varint(std::uint8_t *out, std::uint32_t value) noexcept
+	{
+		std::size_t size = 0;
+		while (value >= 0x80u)
+		{
+			out[size++] = static_cast<std::uint8_t>(value | 0x80u);
+			value >>= 7;
+		}
+		out[size++] = static_cast<std::uint8_t>(value);
+		return size;
+	}
+
+	/**
+	 * @brief Largest encoded size of an argument type.
+	 */
+	template <typename T>
+	constexpr std::size_t max_encoded_size() noexcept
+	{
+		using U = std::decay_t<T>;
+		if constexpr (std::is_same_v<U, const char *> || std::is_same_v<U, char *>)
+			return varint_size(max_string) + max_string;
+		else if constexpr (std::is_floating_point_v<U>)
+			return sizeof(double);
+		else if constexpr (std::is_pointer_v<U>)
+			return sizeof(std::uint32_t);
+		else
+		{
+			static_assert(std::is_integral_v<U> || std::is_enum_v<U>, "Unsupported log argument type");
+			return sizeof(U) > sizeof(std::uint32_t) ? sizeof(std::uint64_t) : sizeof(std::uint32_t);
+		}
+	}
+
+	/**
+	 * @brief Encode one argument.
+	 *
+	 * @return Number of bytes written
+	 */
+	template <typename T>
+	std::size_t encode(std::uint8_t *out, T value) noexcept
+	{
+		using U = std::remove_cv_t<T>;
+		if constexpr (std::is_same_v<U, const char *> || std::is_same_v<U, char *>)
+		{
+			if (value == nullptr)
+			{
+				return put_varint(out, 0);
+			}
+			std::size_t length = 0;
+			while (length < max_string && value[length] != '\0')
+			{
+				++length;
+			}
+			const std::size_t size = put_varint(out, static_cast<std::uint32_t>(length));
+			std::memcpy(out + size, value, length);
+			return size + length;
+		}
+		else if constexpr (std::is_floating_point_v<U>)
+		{
+			const double promoted = value;
+			std::memcpy(out, &promoted, sizeof(promoted));
+			return sizeof(promoted);
+		}
+		else if constexpr (std::is_pointer_v<U>)
+		{
+			const auto address = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(value));
+			std::memcpy(out, &address, sizeof(address));
+			return sizeof(address);
+		}
+		else if constexpr (max_encoded_size<U>() == sizeof(std::uint64_t))
+		{
+			const auto wide = static_cast<std::uint64_t>(value);
+			std::memcpy(out, &wide, sizeof(wide));
+			return sizeof(wide);
+		}
+		else
+		{
+			// Sign extended like the integer promotion of a printf() argument
+			const auto promoted = static_cast<std::uint32_t>(
+				static_cast<std::conditional_t<std::is_signed_v<U>, std::int32_t, std::uint32_t>>(value));
+			std::memcpy(out, &promoted, sizeof(promoted));
+			return sizeof(promoted);
+		}
+	}
+
+	/**
+	 * @brief Encode a log frame and hand it to the sink in one write.
+	 *
+	 * A frame is written as a whole, so the sink's overflow policy decides
+	 * whether it is dropped, but frames are never interleaved.
+	 *
+	 * @tparam Sink  Output with a static write(std::span<const std::uint8_t>)
+	 * @param format Format string inside the .mcal_log section
+	 * @param args   Arguments
+	 */
+	template <typename Sink, typename... Args>
+	void emit(const char *format, const Args &...args) noexcept
+	{
+		constexpr std::size_t header = 2 * varint_size(0xFFFF'FFFFu);
+		std::array<std::uint8_t, header + (std::size_t{0} + ... + max_encoded_size<Args>())> frame;
+
+		// Encode behind the space reserved for the length
+		std::size_t end = header / 2;
+		end += put_varint(frame.data() + end,
+						  static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(format)));
+		((end += encode(frame.data() + end, args)), ...);
+
+		const auto length = static_cast<std::uint32_t>(end - header / 2);
+		const std::size_t start = header / 2 - varint_size(length);
+		put_varint(frame.data() + start, length);
+
+		Sink::write(std::span<const std::uint8_t>(frame.data() + start, end - start));
+	}
+
+	/**
+	 * @brief printf() format check for MCAL_LOG_TO(), never defined or called.
+	 */
+	[[gnu::format(printf, 1, 2)]]
+	void check_format(const char *format, ...) noexcept;
+
+} // namespace mcal::log
+
+/**
+ * @brief Log a message in tokenised form.
+ *
+ * @param sink   Output type, e.g. stm32::f4::log_sink
+ * @param format String literal with printf() syntax
+ */
+#define MCAL_LOG_TO(sink, format, ...)                                                                                 \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		(void)sizeof((::mcal::log::check_format(format __VA_OPT__(, ) __VA_ARGS__), 0));                              \
+		[[gnu::section(".mcal_log"), gnu::used]] static const char mcal_log_format[] = format;                         \
+		::mcal::log::emit<sink>(mcal_log_format __VA_OPT__(, ) __VA_ARGS__);                                          \
+	} while (0)
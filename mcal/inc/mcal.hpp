@@ -5,11 +5,17 @@
 
 #pragma once
 
+#include <bit>
+#include <concepts>
 #include <cstdint>
 
 #include "concepts/concepts.hpp"
 #include "units.hpp"
 
+#ifdef MCAL_HOST
+#include "sim.hpp"
+#endif
+
 namespace mcal
 {
 	/**
@@ -31,16 +37,74 @@ namespace mcal
 		sources source{sources::none};	   //!< Clock source
 	};
 
+	/**
+	 * @brief Typed pointer to a memory mapped peripheral.
+	 *
+	 * On target this is a plain cast of the device address. Host builds
+	 * (MCAL_HOST) map the address onto a simulated register file instead.
+	 *
+	 * @tparam T      Peripheral register layout (e.g. GPIO_TypeDef)
+	 * @param address Device address of the peripheral
+	 * @return Pointer to the peripheral registers
+	 */
+	template <typename T>
+	inline T *peripheral(std::uintptr_t address) noexcept
+	{
+#ifdef MCAL_HOST
+		return static_cast<T *>(sim::map(static_cast<std::uint32_t>(address), sizeof(T)));
+#else
+		return reinterpret_cast<T *>(address);
+#endif
+	}
+
 } // namespace mcal
 
+/**
+ * @brief Staged value for one or more fields of a register.
+ *
+ * Pairs the bits to be written with the mask of affected bits.
+ * Values of different fields are merged with operator| and then
+ * committed together by Register::modify().
+ */
+struct RegisterValue
+{
+	std::uint32_t value{}; //!< Bits to be written
+	std::uint32_t mask{};  //!< Bits affected
+
+	/**
+	 * @brief Merge two staged values.
+	 */
+	constexpr RegisterValue operator|(const RegisterValue &other) const noexcept
+	{
+		return {value | other.value, mask | other.mask};
+	}
+};
+
 /**
  * @brief Register manipulation utilities.
  *
  * Stateless helper functions for safe and expressive
- * bit-level register access.
+ * bit-level register access. All accesses go through load() and
+ * store(), which host builds route over the simulated bus.
  */
 struct Register
 {
+	/**
+	 * @brief Load a register.
+	 *
+	 * @param reg Register to be read
+	 * @return Register value
+	 */
+	[[nodiscard]]
+	static inline std::uint32_t load(const volatile std::uint32_t &reg) noexcept
+	{
+#ifdef MCAL_HOST
+		return mcal::sim::bus::load(reg);
+#else
+		return reg;
+#endif
+	}
+
 	/**
 	 * @brief Set bits in a register.
 	 *
@@ -49,7 +113,7 @@ struct Register
 	 */
 	static inline void set(volatile std::uint32_t &reg, std::uint32_t mask) noexcept
 	{
-		reg |= mask;
+		store(reg, load(reg) | mask);
 	}
 
 	/**
@@ -60,7 +124,25 @@ struct Register
 	 */
 	static inline void clear(volatile std::uint32_t &reg, std::uint32_t mask) noexcept
 	{
-		reg &= ~mask;
+		store(reg, load(reg) & ~mask);
+	}
+
+	/**
+	 * @brief Store a value to a register without reading it first.
+	 *
+	 * Intended for write-only or set/reset style registers (e.g. BSRR)
+	 * where a read-modify-write is neither needed nor wanted.
+	 *
+	 * @param reg   Register to be written
+	 * @param value Value to be stored
+	 */
+	static inline void store(volatile std::uint32_t &reg, std::uint32_t value) noexcept
+	{
+#ifdef MCAL_HOST
+		mcal::sim::bus::store(reg, value);
+#else
+		reg = value;
+#endif
 	}
 
 	/**
@@ -85,7 +167,56 @@ struct Register
 	{
 		static_assert((value & ~mask) == 0u, "value contains bits outside of mask");
 
-		reg = (reg & ~mask) | (value & mask);
+		store(reg, (load(reg) & ~mask) | (value & mask));
+	}
+
+	/**
+	 * @brief Commit staged field values with a single read-modify-write.
+	 *
+	 * All values are merged at compile time. The register is loaded once
+	 * and stored once; if the merged mask covers the whole register the
+	 * load is skipped, and an empty mask leaves the register untouched.
+	 *
+	 * Example:
+	 * @code
+	 * Register::modify<PLLM::value<8>(), PLLN::value<336>(), PLLSRC::value<1>()>(RCC->PLLCFGR);
+	 * @endcode
+	 *
+	 * @tparam values Staged field values, must not overlap
+	 * @param reg     Register to be modified
+	 */
+	template <RegisterValue... values>
+	static inline void modify(volatile std::uint32_t &reg) noexcept
+	{
+		constexpr RegisterValue merged = (RegisterValue{} | ... | values);
+
+		static_assert((0 + ... + std::popcount(values.mask)) == std::popcount(merged.mask),
+					  "staged fields overlap");
+
+		if constexpr (merged.mask == 0xFFFF'FFFFu)
+		{
+			store(reg, merged.value);
+		}
+		else if constexpr (merged.mask != 0u)
+		{
+			write<merged.value, merged.mask>(reg);
+		}
+	}
+
+	/**
+	 * @brief Commit staged runtime field values with a single read-modify-write.
+	 *
+	 * Runtime counterpart of modify<values...>() for field values that are
+	 * not known at compile time.
+	 *
+	 * @param reg    Register to be modified
+	 * @param values Staged field values
+	 */
+	static inline void modify(volatile std::uint32_t &reg, std::same_as<RegisterValue> auto... values) noexcept
+	{
+		const RegisterValue merged = (RegisterValue{} | ... | values);
+
+		store(reg, (load(reg) & ~merged.mask) | (merged.value & merged.mask));
 	}
 
 	/**
@@ -98,6 +229,66 @@ struct Register
 	[[nodiscard]]
 	static inline std::uint32_t read(const volatile std::uint32_t &reg, std::uint32_t mask = 0xFFFF'FFFFu) noexcept
 	{
-		return reg & mask;
+		return load(reg) & mask;
+	}
+};
+
+/**
+ * @brief Typed descriptor of a register bit field.
+ *
+ * Example:
+ * @code
+ * using PLLM = RegisterField<RCC_PLLCFGR_PLLM_Msk, RCC_PLLCFGR_PLLM_Pos>;
+ * using PLLN = RegisterField<RCC_PLLCFGR_PLLN_Msk, RCC_PLLCFGR_PLLN_Pos>;
+ * Register::modify<PLLM::value<8>(), PLLN::value<336>()>(RCC->PLLCFGR);
+ * @endcode
+ *
+ * @tparam Msk Bit mask of the field (CMSIS *_Msk)
+ * @tparam Pos Position of the least significant field bit (CMSIS *_Pos)
+ */
+template <std::uint32_t Msk, std::uint32_t Pos>
+struct RegisterField
+{
+	static_assert(Msk != 0u, "field mask must not be empty");
+	static_assert(Pos == static_cast<std::uint32_t>(std::countr_zero(Msk)), "field position does not match mask");
+
+	static constexpr std::uint32_t mask = Msk;			//!< Bit mask of the field
+	static constexpr std::uint32_t pos = Pos;			//!< Position of the field
+	static constexpr std::uint32_t max = Msk >> Pos; //!< Largest field value
+
+	/**
+	 * @brief Stage a compile time field value.
+	 *
+	 * @tparam v Field value, checked to fit into the field
+	 * @return Staged value
+	 */
+	template <std::uint32_t v>
+	static constexpr RegisterValue value() noexcept
+	{
+		static_assert(v <= max, "value does not fit into field");
+		return {v << Pos, Msk};
+	}
+
+	/**
+	 * @brief Stage a runtime field value.
+	 *
+	 * @param v Field value, surplus bits are dropped
+	 * @return Staged value
+	 */
+	static constexpr RegisterValue make(std::uint32_t v) noexcept
+	{
+		return {(v << Pos) & Msk, Msk};
+	}
+
+	/**
+	 * @brief Read the field from a register.
+	 *
+	 * @param reg Register to be read
+	 * @return Field value
+	 */
+	[[nodiscard]]
+	static std::uint32_t get(const volatile std::uint32_t &reg) noexcept
+	{
+		return Register::read(reg, Msk) >> Pos;
 	}
 };
@@ -0,0 +1,170 @@
+/**
+ * @file ring_buffer.hpp
+ * @brief Lock-free multi-producer, single-consumer byte ring buffer.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace mcal
+{
+	/**
+	 * @brief Behaviour of ring_buffer::write() if the data does not fit.
+	 */
+	enum class overflow : std::uint8_t
+	{
+		drop,	  //!< Drop the whole write, so records are never torn
+		truncate, //!< Store what fits, drop the rest
+	};
+
+	/**
+	 * @brief Lock-free multi-producer, single-consumer byte ring buffer.
+	 *
+	 * Producers may run in thread mode and in any interrupt handler at the
+	 * same time: space is reserved with a compare-and-swap on the write
+	 * index (LDREX/STREX on Cortex-M), then filled without any lock. Data
+	 * becomes visible to the consumer once the last concurrently active
+	 * producer has finished; on a single core, preempting producers always
+	 * finish before the preempted one resumes, so no producer ever waits.
+	 *
+	 * There is exactly one consumer (e.g. an idle hook, a main loop poll
+	 * or one interrupt handler), which reads contiguous chunks with peek()
+	 * and releases them with consume().
+	 *
+	 * Bytes that could not be stored are counted, see dropped().
+	 *
+	 * @tparam Capacity Size in bytes, a power of two
+	 * @tparam Policy   Overflow policy
+	 */
+	template <std::size_t Capacity, overflow Policy = overflow::drop>
+	struct ring_buffer
+	{
+		static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+		static_assert(Capacity <= (1u << 31), "Capacity too large for 32 bit indices");
+
+		/**
+		 * @brief Append data.
+		 *
+		 * Safe to call from any context, including nested interrupts.
+		 *
+		 * @param data Bytes to append
+		 * @return Number of bytes stored
+		 */
+		std::size_t write(std::span<const std::uint8_t> data) noexcept
+		{
+			writers.fetch_add(1, std::memory_order_acquire);
+
+			std::uint32_t start = head.load(std::memory_order_relaxed);
+			std::uint32_t count = 0;
+			do
+			{
+				const std::uint32_t free = Capacity - (start - tail.load(std::memory_order_acquire));
+				if (data.size() <= free)
+					count = static_cast<std::uint32_t>(data.size());
+				else
+					count = (Policy == overflow::truncate) ? free : 0u;
+				if (count == 0)
+					break;
+			} while (!head.compare_exchange_weak(start, start + count, std::memory_order_acq_rel,
+												 std::memory_order_relaxed));
+
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				storage[(start + i) & mask] = data[i];
+			}
+
+			if (count < data.size())
+			{
+				lost.fetch_add(static_cast<std::uint32_t>(data.size() - count), std::memory_order_relaxed);
+			}
+
+			publish();
+			return count;
+		}
+
+		/**
+		 * @brief Oldest contiguous chunk of readable data.
+		 *
+		 * Consumer only. The chunk ends at the wrap-around point; call
+		 * peek() again after consume() to get the rest.
+		 *
+		 * @return Readable bytes, empty if the buffer is empty
+		 */
+		[[nodiscard]]
+		std::span<const std::uint8_t> peek() const noexcept
+		{
+			const std::uint32_t first = tail.load(std::memory_order_relaxed);
+			const std::uint32_t available = published.load(std::memory_order_acquire) - first;
+			const std::uint32_t offset = first & mask;
+			const std::uint32_t contiguous = Capacity - offset;
+			return {storage.data() + offset, available < contiguous ? available : contiguous};
+		}
+
+		/**
+		 * @brief Release bytes returned by peek().
+		 *
+		 * Consumer only.
+		 *
+		 * @param count Number of bytes to release
+		 */
+		void consume(std::size_t count) noexcept
+		{
+			tail.store(tail.load(std::memory_order_relaxed) + static_cast<std::uint32_t>(count),
+					   std::memory_order_release);
+		}
+
+		/**
+		 * @brief Number of readable bytes.
+		 */
+		[[nodiscard]]
+		std::size_t size() const noexcept
+		{
+			return published.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief Number of bytes dropped because the buffer was full.
+		 */
+		[[nodiscard]]
+		std::uint32_t dropped() const noexcept
+		{
+			return lost.load(std::memory_order_relaxed);
+		}
+
+	  private:
+		/**
+		 * @brief Leave the producer section and publish finished data.
+		 *
+		 * Only the last active producer publishes. Every reservation made up
+		 * to that point belongs to a producer which already finished.
+		 */
+		void publish() noexcept
+		{
+			if (writers.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				return;
+
+			const std::uint32_t end = head.load(std::memory_order_acquire);
+			std::uint32_t current = published.load(std::memory_order_relaxed);
+			while (static_cast<std::int32_t>(end - current) > 0 &&
+				   !published.compare_exchange_weak(current, end, std::memory_order_release,
+													std::memory_order_relaxed))
+			{
+			}
+		}
+
+		static constexpr std::uint32_t mask = Capacity - 1; //!< Index mask
+
+		std::array<std::uint8_t, Capacity> storage{}; //!< Data
+		std::atomic<std::uint32_t> head{0};			  //!< End of reserved data
+		std::atomic<std::uint32_t> published{0};	  //!< End of readable data
+		std::atomic<std::uint32_t> tail{0};			  //!< Start of readable data
+		std::atomic<std::uint32_t> writers{0};		  //!< Active producers
+		std::atomic<std::uint32_t> lost{0};			  //!< Dropped bytes
+	};
+
+} // namespace mcal
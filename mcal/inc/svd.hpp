@@ -0,0 +1,240 @@
+/**
+ * @file svd.hpp
+ * @brief Typed register and field descriptors with access policies.
+ *
+ * These templates are the target of the register maps generated from the
+ * vendor SVD files (see tools/svd2hpp.py). Every register knows its
+ * address, reset value, implemented bits and access policy, so misuse
+ * is rejected at compile time:
+ * - writing a read-only register or field,
+ * - reading back a write-only register (including read-modify-write),
+ * - touching reserved bits,
+ * - accidentally clearing write-1-to-clear flags during a read-modify-write.
+ */
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+#include "mcal.hpp"
+
+namespace mcal::svd
+{
+	/**
+	 * @brief Access policies of registers and fields.
+	 */
+	enum class access : std::uint8_t
+	{
+		read_only,		  //!< Writes have no effect
+		write_only,		  //!< Reads return no meaningful value
+		read_write,		  //!< Plain read and write access
+		write_1_to_clear, //!< Readable; writing 1 clears, writing 0 has no effect
+	};
+
+	/**
+	 * @brief Check whether an access policy allows reading.
+	 */
+	constexpr bool readable(access a) noexcept
+	{
+		return a != access::write_only;
+	}
+
+	/**
+	 * @brief Check whether an access policy allows writing.
+	 */
+	constexpr bool writable(access a) noexcept
+	{
+		return a != access::read_only;
+	}
+
+	/**
+	 * @brief Memory mapped 32 bit register.
+	 *
+	 * @tparam Address Absolute address of the register
+	 * @tparam Access  Access policy of the register
+	 * @tparam Reset   Reset value
+	 * @tparam Fields  Mask of all implemented (non reserved) bits
+	 * @tparam W1C     Mask of all write-1-to-clear bits
+	 */
+	template <std::uint32_t Address, access Access, std::uint32_t Reset, std::uint32_t Fields, std::uint32_t W1C = 0u>
+	struct reg
+	{
+		static constexpr std::uint32_t address = Address;	  //!< Absolute address
+		static constexpr access access_policy = Access;		  //!< Access policy
+		static constexpr std::uint32_t reset_value = Reset;	  //!< Reset value
+		static constexpr std::uint32_t field_mask = Fields;	  //!< Implemented bits
+		static constexpr std::uint32_t w1c_mask = W1C;		  //!< Write-1-to-clear bits
+		static constexpr std::uint32_t reserved_mask = ~Fields; //!< Reserved bits
+
+		/**
+		 * @brief Reference to the hardware register.
+		 */
+		static volatile std::uint32_t &ref() noexcept
+		{
+			return *mcal::peripheral<volatile std::uint32_t>(Address);
+		}
+
+		/**
+		 * @brief Read the register.
+		 *
+		 * @return Register value
+		 */
+		[[nodiscard]]
+		static std::uint32_t read() noexcept
+		{
+			static_assert(readable(Access), "register is write-only");
+			return Register::read(ref());
+		}
+
+		/**
+		 * @brief Commit staged field values with a single read-modify-write.
+		 *
+		 * Write-1-to-clear bits which are not staged are written as zero, so
+		 * pending flags are never cleared as a side effect.
+		 *
+		 * @tparam values Staged field values
+		 */
+		template <RegisterValue... values>
+		static void modify() noexcept
+		{
+			static_assert(readable(Access), "read-modify-write of a write-only register, use store()");
+			static_assert(writable(Access), "register is read-only");
+
+			constexpr RegisterValue merged = (RegisterValue{} | ... | values);
+			static_assert((merged.mask & reserved_mask) == 0u, "write touches reserved bits");
+
+			Register::modify<values..., RegisterValue{0u, W1C & ~merged.mask}>(ref());
+		}
+
+		/**
+		 * @brief Commit staged runtime field values with a single read-modify-write.
+		 *
+		 * Like modify<values...>(), but reserved bits cannot be rejected at
+		 * compile time: staged reserved bits are silently left unchanged.
+		 * Values made by field::make() never contain any.
+		 *
+		 * @param values Staged field values
+		 */
+		static void modify(std::same_as<RegisterValue> auto... values) noexcept
+		{
+			static_assert(readable(Access), "read-modify-write of a write-only register, use store()");
+			static_assert(writable(Access), "register is read-only");
+
+			const RegisterValue merged = (RegisterValue{} | ... | values);
+			Register::modify(ref(), RegisterValue{merged.value, merged.mask & Fields},
+							 RegisterValue{0u, W1C & ~merged.mask});
+		}
+
+		/**
+		 * @brief Store staged field values without reading the register.
+		 *
+		 * Bits which are not staged are written with their reset value,
+		 * write-1-to-clear bits which are not staged are written as zero.
+		 *
+		 * @tparam values Staged field values
+		 */
+		template <RegisterValue... values>
+		static void store() noexcept
+		{
+			static_assert(writable(Access), "register is read-only");
+
+			constexpr RegisterValue merged = (RegisterValue{} | ... | values);
+			static_assert((merged.mask & reserved_mask) == 0u, "write touches reserved bits");
+
+			Register::store(ref(), merged.value | (Reset & ~merged.mask & ~W1C));
+		}
+
+		/**
+		 * @brief Store staged runtime field values without reading the register.
+		 *
+		 * Like store<values...>(), but reserved bits cannot be rejected at
+		 * compile time: staged reserved bits are silently replaced by their
+		 * reset value. Values made by field::make() never contain any.
+		 *
+		 * @param values Staged field values
+		 */
+		static void store(std::same_as<RegisterValue> auto... values) noexcept
+		{
+			static_assert(writable(Access), "register is read-only");
+
+			const RegisterValue merged = (RegisterValue{} | ... | values);
+			const std::uint32_t mask = merged.mask & Fields;
+			Register::store(ref(), (merged.value & mask) | (Reset & ~mask & ~W1C));
+		}
+	};
+
+	/**
+	 * @brief Bit field of a register.
+	 *
+	 * @tparam Reg    Register type containing the field
+	 * @tparam Pos    Position of the least significant bit
+	 * @tparam Width  Number of bits
+	 * @tparam Access Access policy of the field
+	 */
+	template <typename Reg, std::uint32_t Pos, std::uint32_t Width, access Access>
+	struct field : RegisterField<((Width >= 32u) ? 0xFFFF'FFFFu : ((1u << Width) - 1u)) << Pos, Pos>
+	{
+		using base = RegisterField<((Width >= 32u) ? 0xFFFF'FFFFu : ((1u << Width) - 1u)) << Pos, Pos>;
+		using reg = Reg; //!< Register containing the field
+
+		static constexpr access access_policy = Access; //!< Access policy
+
+		/**
+		 * @brief Stage a compile time field value.
+		 *
+		 * @tparam v Field value, checked to fit into the field
+		 * @return Staged value
+		 */
+		template <std::uint32_t v>
+		static constexpr RegisterValue value() noexcept
+		{
+			static_assert(writable(Access), "field is read-only");
+			return base::template value<v>();
+		}
+
+		/**
+		 * @brief Stage a runtime field value.
+		 *
+		 * @param v Field value, surplus bits are dropped
+		 * @return Staged value
+		 */
+		static constexpr RegisterValue make(std::uint32_t v) noexcept
+		{
+			static_assert(writable(Access), "field is read-only");
+			return base::make(v);
+		}
+
+		/**
+		 * @brief Read the field.
+		 *
+		 * @return Field value
+		 */
+		[[nodiscard]]
+		static std::uint32_t read() noexcept
+		{
+			static_assert(readable(Access), "field is write-only");
+			return (Reg::read() & base::mask) >> Pos;
+		}
+
+		/**
+		 * @brief Clear a write-1-to-clear flag.
+		 *
+		 * Writes a single 1 to the field; all other flags of the register
+		 * stay untouched.
+		 */
+		static void clear() noexcept
+		{
+			static_assert(Access == access::write_1_to_clear, "field is not write-1-to-clear");
+
+			if constexpr (readable(Reg::access_policy))
+			{
+				Reg::template modify<RegisterValue{base::mask, base::mask}>();
+			}
+			else
+			{
+				Reg::template store<RegisterValue{base::mask, base::mask}>();
+			}
+		}
+	};
+
+} // namespace mcal::svd
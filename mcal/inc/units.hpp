@@ -9,6 +9,7 @@
  */
 #pragma once
 #include <cstdint>
+#include <string_view>
 #include <mp-units/systems/si.h>
 namespace utils
 {
@@ -28,6 +29,9 @@ namespace utils
 		/** @brief Microsecond (10^-6 s). */
 		inline constexpr auto us = mp_units::si::micro<s>;
 
+		/** @brief Nanosecond (10^-9 s). */
+		inline constexpr auto ns = mp_units::si::nano<s>;
+
 		/** @brief Hertz (frequency). */
 		inline constexpr auto Hz = mp_units::one / s;
 
@@ -39,6 +43,38 @@ namespace utils
 
 		/** @brief Millivolt (10^-3 V). */
 		inline constexpr auto mV = mp_units::si::milli<V>;
+
+		/**
+		 * @brief Printed symbol of a unit (see mcal/inc/format.hpp).
+		 *
+		 * Empty for units without a symbol, specialise it for new units.
+		 */
+		template <auto Unit>
+		inline constexpr std::string_view symbol{};
+
+		template <>
+		inline constexpr std::string_view symbol<s> = "s";
+
+		template <>
+		inline constexpr std::string_view symbol<ms> = "ms";
+
+		template <>
+		inline constexpr std::string_view symbol<us> = "us";
+
+		template <>
+		inline constexpr std::string_view symbol<ns> = "ns";
+
+		template <>
+		inline constexpr std::string_view symbol<Hz> = "Hz";
+
+		template <>
+		inline constexpr std::string_view symbol<MHz> = "MHz";
+
+		template <>
+		inline constexpr std::string_view symbol<V> = "V";
+
+		template <>
+		inline constexpr std::string_view symbol<mV> = "mV";
 	} // namespace unit
 
 	/**
@@ -55,6 +91,12 @@ namespace utils
 		/** @brief Time in microseconds. */
 		using us_t = mp_units::quantity<unit::us, std::uint32_t>;
 
+		/** @brief Time in microseconds, 64 bit for monotonic clocks. */
+		using us64_t = mp_units::quantity<unit::us, std::uint64_t>;
+
+		/** @brief Time in nanoseconds. */
+		using ns_t = mp_units::quantity<unit::ns, std::uint32_t>;
+
 		/** @brief Voltage in millivolt. */
 		using mv_t = mp_units::quantity<unit::mV, std::uint32_t>;
 	} // namespace quantity
@@ -35,28 +35,24 @@ static uint8_t *__sbrk_heap_end = NULL;
  *
  * @verbatim
  * ############################################################################
- * #  .data  #  .bss  #       newlib heap       #          MSP stack          #
- * #         #        #                         # Reserved by _Min_Stack_Size #
+ * # .ramfunc .data .bss .dma_buffer .noinit .bss_lazy #    newlib heap       #
  * ############################################################################
- * ^-- RAM start      ^-- _end                             _estack, RAM end --^
+ * ^-- SRAM1 start                                     ^-- _end   SRAM1 end --^
  * @endverbatim
  *
  * This implementation starts allocating at the '_end' linker symbol
- * The '_Min_Stack_Size' linker symbol reserves a memory for the MSP stack
- * The implementation considers '_estack' linker symbol to be RAM end
- * NOTE: If the MSP stack, at any point during execution, grows larger than the
- * reserved size, please increase the '_Min_Stack_Size'.
+ * The implementation considers '_heap_limit' linker symbol (SRAM1 end) to be the heap end.
+ * The MSP stack lives in SRAM2 (see the linker script), so the heap can not
+ * grow into it.
  *
  * @param incr Memory size
  * @return Pointer to allocated memory
  */
 void *_sbrk(ptrdiff_t incr)
 {
-	extern uint8_t _end;			 /* Symbol defined in the linker script */
-	extern uint8_t _estack;			 /* Symbol defined in the linker script */
-	extern uint32_t _Min_Stack_Size; /* Symbol defined in the linker script */
-	const uint32_t stack_limit = (uint32_t)&_estack - (uint32_t)&_Min_Stack_Size;
-	const uint8_t *max_heap = (uint8_t *)stack_limit;
+	extern uint8_t _end;		/* Symbol defined in the linker script */
+	extern uint8_t _heap_limit; /* Symbol defined in the linker script */
+	const uint8_t *max_heap = &_heap_limit;
 	uint8_t *prev_heap_end;
 
 	/* Initialize heap end at first call */
@@ -65,7 +61,7 @@ void *_sbrk(ptrdiff_t incr)
 		__sbrk_heap_end = &_end;
 	}
 
-	/* Protect heap from growing into the reserved MSP stack */
+	/* Protect heap from growing beyond SRAM1 */
 	if (__sbrk_heap_end + incr > max_heap)
 	{
 		errno = ENOMEM;
@@ -5,10 +5,12 @@
 
 #pragma once
 
+#include <bit>
 #include <cstdint>
 
 #include "mcal.hpp"
-#include "stm32f4xx.h"
+#include "device.hpp"
+#include "pll.hpp"
 
 namespace stm32::f4
 {
@@ -17,17 +19,19 @@ namespace stm32::f4
 	 *
 	 * @tparam target_system_clock Desired system clock frequency.
 	 * @tparam external_source        Optional external clock source.
+	 * @tparam main_pll               Optional Q and R outputs of the main PLL (e.g. 48 MHz for
+	 *                                USB/SDIO) and the tolerance of all PLL outputs. P is ignored,
+	 *                                it always provides the system clock.
 	 */
 	template <utils::quantity::Hz_t target_system_clock,
-			  mcal::clock external_source = {0 * utils::unit::Hz, mcal::clock::sources::clock}>
+			  mcal::clock external_source = {0 * utils::unit::Hz, mcal::clock::sources::clock},
+			  pll_outputs main_pll = {}>
 	struct clock_tree
 	{
 		static_assert(!(external_source.source != mcal::clock::sources::none &&
 						external_source.frequency == 0 * utils::unit::Hz),
 					  "External clock source specified but frequency is zero");
 
-		static_assert(target_system_clock <= 180 * utils::unit::MHz, "STM32F4 system clock must not exceed 180 MHz");
-
 		/**
 		 * @brief Internal high-speed oscillator frequency.
 		 *
@@ -92,6 +96,54 @@ namespace stm32::f4
 			return (root_source() == sources::HSE) ? HSE_frequency : HSI_frequency;
 		}
 
+		/**
+		 * @brief Solved main PLL configuration
+		 *
+		 * All zero if the system clock runs directly from HSI or HSE.
+		 *
+		 * @return constexpr pll_config
+		 */
+		static constexpr pll_config main_pll_config() noexcept
+		{
+			return (root_frequency() != target_system_clock)
+					   ? PLL_P::calculate(target_system_clock, root_frequency())
+					   : pll_config{};
+		}
+
+		/**
+		 * @brief Actual system clock frequency
+		 *
+		 * Equals the target unless the main PLL tolerance allows a deviation.
+		 *
+		 * @return constexpr utils::quantity::Hz_t
+		 */
+		static constexpr utils::quantity::Hz_t system_clock() noexcept
+		{
+			return (root_frequency() != target_system_clock)
+					   ? main_pll_config().output(root_frequency(), main_pll_config().P)
+					   : root_frequency();
+		}
+
+		/**
+		 * @brief Main PLL Q output, the 48 MHz clock of USB, SDIO and RNG
+		 *
+		 * @return constexpr utils::quantity::Hz_t zero if not requested
+		 */
+		static constexpr utils::quantity::Hz_t pll_q_clock() noexcept
+		{
+			return main_pll_config().output(root_frequency(), main_pll_config().Q);
+		}
+
+		/**
+		 * @brief Main PLL R output (I2S, SAI, SPDIF-Rx)
+		 *
+		 * @return constexpr utils::quantity::Hz_t zero if not requested
+		 */
+		static constexpr utils::quantity::Hz_t pll_r_clock() noexcept
+		{
+			return main_pll_config().output(root_frequency(), main_pll_config().R);
+		}
+
 		/**
 		 * @brief Current source (read via register)
 		 *
@@ -101,6 +153,12 @@ namespace stm32::f4
 		{
 			return static_cast<sources>((Register::read(RCC->CFGR, RCC_CFGR_SWS_Msk) >> RCC_CFGR_SWS_Pos));
 		}
+		/**
+		 * @brief System clock switch field (RCC_CFGR.SW)
+		 *
+		 */
+		using SW = RegisterField<RCC_CFGR_SW_Msk, RCC_CFGR_SW_Pos>;
+
 		/**
 		 * @brief Set the sysclock source register
 		 *
@@ -109,94 +167,224 @@ namespace stm32::f4
 		template <sources source>
 		static void set_sysclock_source() noexcept
 		{
-			Register::write<(static_cast<std::uint32_t>(source) << RCC_CFGR_SW_Pos), RCC_CFGR_SW_Msk>(RCC->CFGR);
+			Register::modify<SW::value<static_cast<std::uint32_t>(source)>()>(RCC->CFGR);
 		}
 
 		/**
-		 * @brief PLL configuration parameters.
+		 * @brief Wait until the system clock switch status reports a source
 		 *
-		 * Represents the three core parameters of the STM32F4 main PLL.
-		 * These values determine the VCO input frequency, VCO output
-		 * frequency, and the final system clock output (PLL_P).
+		 * The switch takes a few cycles of both clocks, until then the core
+		 * still runs from the previous source.
 		 *
+		 * @tparam source The clock source set with set_sysclock_source()
 		 */
-		struct config
+		template <sources source>
+		static void wait_for_sysclock_source() noexcept
 		{
-			uint32_t M; //!< Dividor M allowed values: 2 .. 63
-			uint32_t N; //!< Multiplyer N allowed values: 50 .. 432
-			uint32_t P; //!< Dividor P allowed values:  2, 4, 6, 8
-		};
+			while (sysclock_source() != source)
+			{
+			}
+		}
+
+		/**
+		 * @brief Maximum APB1 (low speed) bus frequency.
+		 *
+		 */
+		static constexpr utils::quantity::Hz_t APB1_max_frequency = 45 * utils::unit::MHz;
+
+		/**
+		 * @brief Maximum APB2 (high speed) bus frequency.
+		 *
+		 */
+		static constexpr utils::quantity::Hz_t APB2_max_frequency = 90 * utils::unit::MHz;
+
+		/**
+		 * @brief Smallest APB divider keeping a bus within its limit
+		 *
+		 * @param limit Maximum bus frequency
+		 * @return constexpr std::uint32_t divider: 1, 2, 4, 8 or 16
+		 */
+		static constexpr std::uint32_t apb_divider(utils::quantity::Hz_t limit) noexcept
+		{
+			std::uint32_t divider = 1;
+			while (divider < 16 && hclk() / divider > limit)
+			{
+				divider *= 2;
+			}
+			return divider;
+		}
+
+		/**
+		 * @brief AHB prescaler (HCLK = SYSCLK / AHB_divider).
+		 *
+		 * The core and the AHB bus run at the full system clock.
+		 */
+		static constexpr std::uint32_t AHB_divider = 1;
+
+		/**
+		 * @brief AHB clock (HCLK) frequency, also the core clock
+		 *
+		 * @return constexpr utils::quantity::Hz_t
+		 */
+		static constexpr utils::quantity::Hz_t hclk() noexcept
+		{
+			return system_clock() / AHB_divider;
+		}
+
+		static constexpr std::uint32_t APB1_divider = apb_divider(APB1_max_frequency); //!< APB1 prescaler
+		static constexpr std::uint32_t APB2_divider = apb_divider(APB2_max_frequency); //!< APB2 prescaler
+
+		static_assert(system_clock() <= 180 * utils::unit::MHz, "STM32F4 system clock must not exceed 180 MHz");
+		static_assert(hclk() / APB1_divider <= APB1_max_frequency, "No valid APB1 prescaler found");
+		static_assert(hclk() / APB2_divider <= APB2_max_frequency, "No valid APB2 prescaler found");
+
+		/**
+		 * @brief APB1 peripheral clock (PCLK1) frequency
+		 *
+		 * @return constexpr utils::quantity::Hz_t
+		 */
+		static constexpr utils::quantity::Hz_t pclk1() noexcept
+		{
+			return hclk() / APB1_divider;
+		}
+
+		/**
+		 * @brief APB2 peripheral clock (PCLK2) frequency
+		 *
+		 * @return constexpr utils::quantity::Hz_t
+		 */
+		static constexpr utils::quantity::Hz_t pclk2() noexcept
+		{
+			return hclk() / APB2_divider;
+		}
+
+		/**
+		 * @brief Clock of the timers on APB1 (TIM2 ... TIM7, TIM12 ... TIM14)
+		 *
+		 * Twice PCLK1 if APB1 is divided (RCC_DCKCFGR.TIMPRE = 0).
+		 *
+		 * @return constexpr utils::quantity::Hz_t
+		 */
+		static constexpr utils::quantity::Hz_t timer_clock1() noexcept
+		{
+			return (APB1_divider == 1) ? pclk1() : pclk1() * 2u;
+		}
+
+		/**
+		 * @brief Clock of the timers on APB2 (TIM1, TIM8 ... TIM11)
+		 *
+		 * Twice PCLK2 if APB2 is divided (RCC_DCKCFGR.TIMPRE = 0).
+		 *
+		 * @return constexpr utils::quantity::Hz_t
+		 */
+		static constexpr utils::quantity::Hz_t timer_clock2() noexcept
+		{
+			return (APB2_divider == 1) ? pclk2() : pclk2() * 2u;
+		}
+
+		using HPRE = RegisterField<RCC_CFGR_HPRE_Msk, RCC_CFGR_HPRE_Pos>;	//!< AHB prescaler
+		using PPRE1 = RegisterField<RCC_CFGR_PPRE1_Msk, RCC_CFGR_PPRE1_Pos>; //!< APB1 prescaler
+		using PPRE2 = RegisterField<RCC_CFGR_PPRE2_Msk, RCC_CFGR_PPRE2_Pos>; //!< APB2 prescaler
+
+		/**
+		 * @brief Encode an AHB divider for RCC_CFGR.HPRE
+		 *
+		 * @param divider 1, 2, 4, 8, 16, 64, 128, 256 or 512
+		 * @return constexpr std::uint32_t field value
+		 */
+		static constexpr std::uint32_t ahb_prescaler(std::uint32_t divider) noexcept
+		{
+			if (divider <= 1)
+				return 0b0000;
+			const std::uint32_t log2 = static_cast<std::uint32_t>(std::countr_zero(divider));
+			// 32 is skipped by the AHB prescaler
+			return 0b1000 | (log2 > 5 ? log2 - 2 : log2 - 1);
+		}
+
+		/**
+		 * @brief Encode an APB divider for RCC_CFGR.PPREx
+		 *
+		 * @param divider 1, 2, 4, 8 or 16
+		 * @return constexpr std::uint32_t field value
+		 */
+		static constexpr std::uint32_t apb_prescaler(std::uint32_t divider) noexcept
+		{
+			if (divider <= 1)
+				return 0b000;
+			return 0b100 | (static_cast<std::uint32_t>(std::countr_zero(divider)) - 1);
+		}
+
+		/**
+		 * @brief Staged AHB, APB1 and APB2 prescalers for RCC_CFGR
+		 *
+		 * @return constexpr RegisterValue
+		 */
+		static constexpr RegisterValue bus_prescalers() noexcept
+		{
+			return HPRE::value<ahb_prescaler(AHB_divider)>() | PPRE1::value<apb_prescaler(APB1_divider)>() |
+				   PPRE2::value<apb_prescaler(APB2_divider)>();
+		}
+
+		/**
+		 * @brief Program the AHB and APB prescalers
+		 *
+		 * Has to run before the system clock is raised, so the buses never
+		 * exceed their limits.
+		 *
+		 */
+		static void set_bus_prescalers() noexcept
+		{
+			Register::modify<bus_prescalers()>(RCC->CFGR);
+		}
+
+		/**
+		 * @brief Main PLL register access
+		 *
+		 */
 		struct PLL_P
 		{
+			using config = pll_config; //!< M, N and the P, Q and R dividers
+
 			/**
-			 * @brief PLL configuration parameters.
+			 * @brief Computes the main PLL configuration for a system clock.
 			 *
-			 * Represents the three core parameters of the STM32F4 main PLL.
-			 * These values determine the VCO input frequency, VCO output
-			 * frequency, and the final system clock output (PLL_P).
+			 * Solves P for @p target together with the Q and R outputs
+			 * requested by @p main_pll, see pll_solve().
 			 *
+			 * @param target  Desired clk_p output frequency in Hz (system clock target).
+			 * @param source  Input clock frequency in Hz.
+			 *
+			 * @return A valid PLL configuration if found, all zero otherwise.
 			 */
-			struct config
+			static constexpr config calculate(utils::quantity::Hz_t target, utils::quantity::Hz_t source) noexcept
 			{
-				std::uint32_t M; //!< 2 … 63
-				std::uint32_t N; //!< 50 … 432
-				std::uint32_t P; //!< {2,4,6,8}
-			};
+				return pll_solve(source, {target, main_pll.Q, main_pll.R, main_pll.tolerance_ppm});
+			}
+
+			using PLLM = RegisterField<RCC_PLLCFGR_PLLM_Msk, RCC_PLLCFGR_PLLM_Pos>;		  //!< Input divider
+			using PLLN = RegisterField<RCC_PLLCFGR_PLLN_Msk, RCC_PLLCFGR_PLLN_Pos>;		  //!< VCO multiplier
+			using PLLP = RegisterField<RCC_PLLCFGR_PLLP_Msk, RCC_PLLCFGR_PLLP_Pos>;		  //!< Output divider P
+			using PLLSRC = RegisterField<RCC_PLLCFGR_PLLSRC_Msk, RCC_PLLCFGR_PLLSRC_Pos>; //!< Input source
+			using PLLQ = RegisterField<RCC_PLLCFGR_PLLQ_Msk, RCC_PLLCFGR_PLLQ_Pos>;		  //!< Output divider Q
+			using PLLR = RegisterField<RCC_PLLCFGR_PLLR_Msk, RCC_PLLCFGR_PLLR_Pos>;		  //!< Output divider R
 
 			/**
-			 * @brief Computes a valid PLL configuration for a desired output frequency.
-			 *
-			 * This function performs a bounded search over all valid PLL parameter
-			 * combinations (M, N, P) as defined by the STM32F4 PLL constraints.
-			 * It attempts to find a configuration that produces the exact target
-			 * output frequency on the PLL_P output.
-			 *
-			 * The search respects all limits from RM0390:
-			 * - M: 2 … 63
-			 * - N: 50 … 432
-			 * - P: {2, 4, 6, 8}
-			 * - clk_m  = source / M     1 ... 2 MHz
-			 * - clk_n  = clk_m * N      100 ...432 MHz
-			 * - clk_p  = clk_n / P      @p target exactly
+			 * @brief Stage the dividers of a config for PLLCFGR
 			 *
-			 * The algorithm iterates M → N → P in ascending order and returns the
-			 * first valid configuration that satisfies all constraints.
-			 *
-			 * @param target  Desired clk_p output frequency in Hz (system clock target).
-			 * @param source  Input clock frequency in Hz.
+			 * Unused Q and R outputs keep their current dividers.
 			 *
-			 * @return A valid PLL configuration {M, N, P} if found.
-			 *         Returns {0, 0, 0} if no valid configuration exists.
-			 *
-			 * @note This function is constexpr and can therefore be evaluated at
-			 *       compile time, enabling full static validation of clock setups.
+			 * @tparam cfg
+			 * @return Staged PLLM, PLLN, PLLP and the used PLLQ and PLLR fields
 			 */
-			static constexpr config calculate(utils::quantity::Hz_t target, utils::quantity::Hz_t source) noexcept
+			template <config cfg>
+			static constexpr RegisterValue staged() noexcept
 			{
-				for (std::uint32_t M = 2; M <= 63; ++M)
-				{
-					const auto clk_m = source / M;
-					if (clk_m > 2 * utils::unit::MHz)
-						continue;
-					if (clk_m < 1 * utils::unit::MHz)
-						break;
-
-					for (std::uint32_t N = 50; N <= 432; ++N)
-					{
-						const auto clk_n = clk_m * N;
-						if (clk_n < 100 * utils::unit::MHz || clk_n > 432 * utils::unit::MHz)
-							continue;
-
-						for (std::uint32_t P = 2; P <= 8; P += 2)
-						{
-							if ((clk_n / P) == target)
-							{
-								return {M, N, P};
-							}
-						}
-					}
-				}
-				return {0, 0, 0};
+				RegisterValue value = PLLM::value<cfg.M>() | PLLN::value<cfg.N>() | PLLP::value<(cfg.P / 2) - 1>();
+				if constexpr (cfg.Q != 0)
+					value = value | PLLQ::value<cfg.Q>();
+				if constexpr (cfg.R != 0)
+					value = value | PLLR::value<cfg.R>();
+				return value;
 			}
 
 			/**
@@ -207,13 +395,22 @@ namespace stm32::f4
 			template <config cfg>
 			static void set() noexcept
 			{
-				constexpr std::uint32_t value = ((cfg.M << RCC_PLLCFGR_PLLM_Pos) & RCC_PLLCFGR_PLLM_Msk) |
-												((cfg.N << RCC_PLLCFGR_PLLN_Pos) & RCC_PLLCFGR_PLLN_Msk) |
-												((((cfg.P / 2) - 1) << RCC_PLLCFGR_PLLP_Pos) & RCC_PLLCFGR_PLLP_Msk);
-
-				constexpr std::uint32_t mask = RCC_PLLCFGR_PLLM_Msk | RCC_PLLCFGR_PLLN_Msk | RCC_PLLCFGR_PLLP_Msk;
+				Register::modify<staged<cfg>()>(RCC->PLLCFGR);
+			}
 
-				Register::write<value, mask>(RCC->PLLCFGR);
+			/**
+			 * @brief Write the config and the input source into PLLCFGR
+			 *
+			 * Equivalent to set() followed by set_source(), but with a single
+			 * read-modify-write of PLLCFGR.
+			 *
+			 * @tparam cfg
+			 * @tparam source Could be HSE or HSI
+			 */
+			template <config cfg, sources source>
+			static void configure() noexcept
+			{
+				Register::modify<staged<cfg>(), PLLSRC::value<(source == sources::HSE) ? 1u : 0u>()>(RCC->PLLCFGR);
 			}
 
 			/**
@@ -233,10 +430,16 @@ namespace stm32::f4
 			/**
 			 * @brief Disables the PLL.
 			 *
+			 * Waits until PLL ready is cleared. The PLL must not be the system
+			 * clock, PLLON can not be cleared then.
+			 *
 			 */
 			static void disable() noexcept
 			{
 				Register::clear(RCC->CR, RCC_CR_PLLON);
+				while (is_ready())
+				{
+				}
 			}
 
 			/**
@@ -248,13 +451,22 @@ namespace stm32::f4
 			 */
 			static void set_source(sources source) noexcept
 			{
-				if (source == sources::HSE)
-				{
-					Register::set(RCC->PLLCFGR, RCC_PLLCFGR_PLLSRC);
-				}
-				else
+				Register::modify(RCC->PLLCFGR, PLLSRC::make(source == sources::HSE ? 1u : 0u));
+			}
+
+			/**
+			 * @brief Select the root source as input of all PLLs
+			 *
+			 * PLLSRC is shared with PLLI2S and PLLSAI and must not change while
+			 * a PLL runs. A running main PLL was configured by init() from the
+			 * same root source, so the register is left alone then.
+			 *
+			 */
+			static void select_root_source() noexcept
+			{
+				if (!Register::read(RCC->CR, RCC_CR_PLLON))
 				{
-					Register::clear(RCC->PLLCFGR, RCC_PLLCFGR_PLLSRC);
+					set_source(root_source());
 				}
 			}
 
@@ -271,6 +483,169 @@ namespace stm32::f4
 			}
 		};
 
+		/**
+		 * @brief PLLI2S register access
+		 *
+		 * Shares the input source (PLLSRC) with the main PLL but has its own
+		 * input divider.
+		 *
+		 */
+		struct PLL_I2S
+		{
+			using PLLM = RegisterField<RCC_PLLI2SCFGR_PLLI2SM_Msk, RCC_PLLI2SCFGR_PLLI2SM_Pos>; //!< Input divider
+			using PLLN = RegisterField<RCC_PLLI2SCFGR_PLLI2SN_Msk, RCC_PLLI2SCFGR_PLLI2SN_Pos>; //!< VCO multiplier
+			using PLLP = RegisterField<RCC_PLLI2SCFGR_PLLI2SP_Msk, RCC_PLLI2SCFGR_PLLI2SP_Pos>; //!< Output divider P
+			using PLLQ = RegisterField<RCC_PLLI2SCFGR_PLLI2SQ_Msk, RCC_PLLI2SCFGR_PLLI2SQ_Pos>; //!< Output divider Q
+			using PLLR = RegisterField<RCC_PLLI2SCFGR_PLLI2SR_Msk, RCC_PLLI2SCFGR_PLLI2SR_Pos>; //!< Output divider R
+
+			/**
+			 * @brief Solve PLLI2S for the requested outputs
+			 *
+			 * @tparam out Requested P, Q and R frequencies
+			 * @return constexpr pll_config
+			 */
+			template <pll_outputs out>
+			static constexpr pll_config calculate() noexcept
+			{
+				return pll_solve(root_frequency(), out, pll_main_limits);
+			}
+
+			/**
+			 * @brief Configure and enable PLLI2S
+			 *
+			 * Programs PLLSRC if the main PLL is off, e.g. with SYSCLK taken
+			 * directly from HSE. Waits until PLLI2S ready is set.
+			 *
+			 * @tparam out Requested P, Q and R frequencies
+			 */
+			template <pll_outputs out>
+			static void init() noexcept
+			{
+				constexpr pll_config cfg = calculate<out>();
+				static_assert(cfg.valid(), "No valid PLLI2S configuration found");
+
+				constexpr RegisterValue value =
+					PLLM::value<cfg.M>() | PLLN::value<cfg.N>() |
+					(cfg.P ? PLLP::value<(cfg.P ? cfg.P / 2 - 1 : 0)>() : RegisterValue{}) |
+					(cfg.Q ? PLLQ::value<cfg.Q>() : RegisterValue{}) | (cfg.R ? PLLR::value<cfg.R>() : RegisterValue{});
+
+				disable();
+				PLL_P::select_root_source();
+				Register::modify<value>(RCC->PLLI2SCFGR);
+				Register::set(RCC->CR, RCC_CR_PLLI2SON);
+				while (!is_ready())
+				{
+				}
+			}
+
+			/**
+			 * @brief Disables PLLI2S.
+			 *
+			 * Waits until PLLI2S ready is cleared.
+			 *
+			 */
+			static void disable() noexcept
+			{
+				Register::clear(RCC->CR, RCC_CR_PLLI2SON);
+				while (is_ready())
+				{
+				}
+			}
+
+			/**
+			 * @brief Checks if PLLI2S is ready to use.
+			 *
+			 * @return true PLLI2S is ready to use.
+			 * @return false PLLI2S is NOT ready to use.
+			 */
+			[[nodiscard]]
+			static bool is_ready() noexcept
+			{
+				return Register::read(RCC->CR, RCC_CR_PLLI2SRDY);
+			}
+		};
+
+		/**
+		 * @brief PLLSAI register access
+		 *
+		 * Shares the input source (PLLSRC) with the main PLL but has its own
+		 * input divider. PLLSAI has no R output.
+		 *
+		 */
+		struct PLL_SAI
+		{
+			using PLLM = RegisterField<RCC_PLLSAICFGR_PLLSAIM_Msk, RCC_PLLSAICFGR_PLLSAIM_Pos>; //!< Input divider
+			using PLLN = RegisterField<RCC_PLLSAICFGR_PLLSAIN_Msk, RCC_PLLSAICFGR_PLLSAIN_Pos>; //!< VCO multiplier
+			using PLLP = RegisterField<RCC_PLLSAICFGR_PLLSAIP_Msk, RCC_PLLSAICFGR_PLLSAIP_Pos>; //!< Output divider P
+			using PLLQ = RegisterField<RCC_PLLSAICFGR_PLLSAIQ_Msk, RCC_PLLSAICFGR_PLLSAIQ_Pos>; //!< Output divider Q
+
+			/**
+			 * @brief Solve PLLSAI for the requested outputs
+			 *
+			 * @tparam out Requested P and Q frequencies
+			 * @return constexpr pll_config
+			 */
+			template <pll_outputs out>
+			static constexpr pll_config calculate() noexcept
+			{
+				return pll_solve(root_frequency(), out, pll_sai_limits);
+			}
+
+			/**
+			 * @brief Configure and enable PLLSAI
+			 *
+			 * Programs PLLSRC if the main PLL is off, e.g. with SYSCLK taken
+			 * directly from HSE. Waits until PLLSAI ready is set.
+			 *
+			 * @tparam out Requested P and Q frequencies
+			 */
+			template <pll_outputs out>
+			static void init() noexcept
+			{
+				constexpr pll_config cfg = calculate<out>();
+				static_assert(cfg.valid(), "No valid PLLSAI configuration found");
+
+				constexpr RegisterValue value =
+					PLLM::value<cfg.M>() | PLLN::value<cfg.N>() |
+					(cfg.P ? PLLP::value<(cfg.P ? cfg.P / 2 - 1 : 0)>() : RegisterValue{}) |
+					(cfg.Q ? PLLQ::value<cfg.Q>() : RegisterValue{});
+
+				disable();
+				PLL_P::select_root_source();
+				Register::modify<value>(RCC->PLLSAICFGR);
+				Register::set(RCC->CR, RCC_CR_PLLSAION);
+				while (!is_ready())
+				{
+				}
+			}
+
+			/**
+			 * @brief Disables PLLSAI.
+			 *
+			 * Waits until PLLSAI ready is cleared.
+			 *
+			 */
+			static void disable() noexcept
+			{
+				Register::clear(RCC->CR, RCC_CR_PLLSAION);
+				while (is_ready())
+				{
+				}
+			}
+
+			/**
+			 * @brief Checks if PLLSAI is ready to use.
+			 *
+			 * @return true PLLSAI is ready to use.
+			 * @return false PLLSAI is NOT ready to use.
+			 */
+			[[nodiscard]]
+			static bool is_ready() noexcept
+			{
+				return Register::read(RCC->CR, RCC_CR_PLLSAIRDY);
+			}
+		};
+
 		/**
 		 * @brief HSE register access
 		 *
@@ -366,9 +741,163 @@ namespace stm32::f4
 			}
 		};
 
+		/**
+		 * @brief Main regulator output voltage scales (PWR_CR.VOS).
+		 */
+		enum class voltage_scale : std::uint32_t
+		{
+			scale3 = 0b01, //!< HCLK up to 120 MHz, lowest power
+			scale2 = 0b10, //!< HCLK up to 144 MHz
+			scale1 = 0b11, //!< HCLK up to 168 MHz, 180 MHz with over-drive
+		};
+
+		/**
+		 * @brief Lowest regulator scale supporting the actual HCLK frequency (RM0390, 5.1.3)
+		 *
+		 * Based on hclk(), which may lie above the target within the PLL tolerance.
+		 *
+		 * @return constexpr voltage_scale
+		 */
+		static constexpr voltage_scale regulator_scale() noexcept
+		{
+			if (hclk() <= 120 * utils::unit::MHz)
+				return voltage_scale::scale3;
+			if (hclk() <= 144 * utils::unit::MHz)
+				return voltage_scale::scale2;
+			return voltage_scale::scale1;
+		}
+
+		/**
+		 * @brief Over-drive is required above 168 MHz HCLK.
+		 */
+		static constexpr bool over_drive = hclk() > 168 * utils::unit::MHz;
+
+		/**
+		 * @brief Main regulator voltage scaling and over-drive control
+		 *
+		 */
+		struct regulator
+		{
+			using VOS = RegisterField<PWR_CR_VOS_Msk, PWR_CR_VOS_Pos>; //!< Regulator voltage scale
+
+			/**
+			 * @brief Select the regulator voltage scale.
+			 *
+			 * Only allowed while the PLL is off, the scale takes effect when
+			 * the PLL is enabled.
+			 *
+			 * @tparam scale
+			 */
+			template <voltage_scale scale>
+			static void set_scale() noexcept
+			{
+				Register::set(RCC->APB1ENR, RCC_APB1ENR_PWREN);
+				Register::modify<VOS::value<static_cast<std::uint32_t>(scale)>()>(PWR->CR);
+			}
+
+			/**
+			 * @brief Current regulator voltage scale.
+			 *
+			 * @return voltage_scale
+			 */
+			[[nodiscard]]
+			static voltage_scale scale() noexcept
+			{
+				return static_cast<voltage_scale>(VOS::get(PWR->CR));
+			}
+
+			/**
+			 * @brief Enable over-drive and switch to it.
+			 *
+			 * Has to run with the PLL enabled but not yet selected as
+			 * system clock (RM0390, 5.1.4).
+			 *
+			 */
+			static void enable_over_drive() noexcept
+			{
+				Register::set(PWR->CR, PWR_CR_ODEN);
+				while (!Register::read(PWR->CSR, PWR_CSR_ODRDY))
+				{
+				}
+				Register::set(PWR->CR, PWR_CR_ODSWEN);
+				while (!is_over_drive())
+				{
+				}
+			}
+
+			/**
+			 * @brief Leave over-drive mode.
+			 *
+			 * The system clock must not run from the PLL.
+			 *
+			 */
+			static void disable_over_drive() noexcept
+			{
+				Register::clear(PWR->CR, PWR_CR_ODEN | PWR_CR_ODSWEN);
+				while (Register::read(PWR->CSR, PWR_CSR_ODSWRDY))
+				{
+				}
+			}
+
+			/**
+			 * @brief Checks if the over-drive switch is active.
+			 *
+			 * @return true Over-drive is active.
+			 * @return false Over-drive is NOT active.
+			 */
+			[[nodiscard]]
+			static bool is_over_drive() noexcept
+			{
+				return Register::read(PWR->CSR, PWR_CSR_ODSWRDY);
+			}
+		};
+
+		/**
+		 * @brief Check whether the clock tree already runs the target configuration
+		 *
+		 * Allows init() to be skipped when the clock was brought up early,
+		 * e.g. from SystemEarlyInit() in Reset_Handler.
+		 *
+		 * @return true The system clock source and PLL match this configuration.
+		 * @return false The clock tree still has to be initialised.
+		 */
+		[[nodiscard]]
+		static bool is_configured() noexcept
+		{
+			if constexpr (root_frequency() != target_system_clock)
+			{
+				constexpr auto cfg = main_pll_config();
+				constexpr RegisterValue expected =
+					PLL_P::template staged<cfg>() |
+					PLL_P::PLLSRC::template value<(root_source() == sources::HSE) ? 1u : 0u>();
+
+				return sysclock_source() == sources::PLL_P &&
+					   Register::read(RCC->CFGR, bus_prescalers().mask) == bus_prescalers().value &&
+					   Register::read(RCC->PLLCFGR, expected.mask) == expected.value &&
+					   regulator::scale() == regulator_scale() && regulator::is_over_drive() == over_drive;
+			}
+			else
+			{
+				return sysclock_source() == root_source() &&
+					   Register::read(RCC->CFGR, bus_prescalers().mask) == bus_prescalers().value;
+			}
+		}
+
 		/**
 		 * @brief Initialise the clock tree
 		 *
+		 * Selects the lowest regulator voltage scale for the target frequency
+		 * and runs the over-drive sequence above 168 MHz. The flash latency
+		 * has to be raised beforehand.
+		 *
+		 * Safe at reset and at runtime with the PLL as system clock (see
+		 * clock_profiles): the system clock is moved to HSE/HSI first, and
+		 * over-drive, PLL and the unused oscillator are only switched off
+		 * once the switch status confirms it.
+		 *
+		 * Does not depend on initialised .data/.bss, so it may run from
+		 * SystemEarlyInit() before the C runtime is set up.
+		 *
 		 */
 		static void init() noexcept
 		{
@@ -376,32 +905,53 @@ namespace stm32::f4
 			{
 				HSE::enable();
 				set_sysclock_source<sources::HSE>();
-				HSI::disable();
+				wait_for_sysclock_source<sources::HSE>();
 			}
 			else
 			{
 				HSI::enable();
 				set_sysclock_source<sources::HSI>();
+				wait_for_sysclock_source<sources::HSI>();
+			}
+
+			// The system clock no longer runs from the PLL
+			if (regulator::is_over_drive())
+			{
+				regulator::disable_over_drive();
+			}
+			PLL_P::disable();
+
+			if constexpr (root_source() == sources::HSE)
+			{
+				HSI::disable();
+			}
+			else
+			{
 				HSE::disable();
 			}
 
 			if constexpr (root_frequency() != target_system_clock)
 			{
-				PLL_P::disable();
-
-				constexpr auto cfg = PLL_P::calculate(target_system_clock, root_frequency());
+				constexpr auto cfg = main_pll_config();
 
 				static_assert(cfg.M != 0, "No valid PLL configuration found");
 
-				PLL_P::template set<cfg>();
-				PLL_P::set_source(root_source());
+				regulator::template set_scale<regulator_scale()>();
+				PLL_P::template configure<cfg, root_source()>();
 				PLL_P::enable();
 
+				if constexpr (over_drive)
+				{
+					regulator::enable_over_drive();
+				}
+
+				set_bus_prescalers();
 				set_sysclock_source<sources::PLL_P>();
+				wait_for_sysclock_source<sources::PLL_P>();
 			}
 			else
 			{
-				PLL_P::disable();
+				set_bus_prescalers();
 			}
 
 			SystemCoreClockUpdate();
@@ -0,0 +1,188 @@
+/**
+ * @file clock_profiles.hpp
+ * @brief Runtime switching between precomputed clock tree configurations.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "clock.hpp"
+#include "flash.hpp"
+
+#include "units.hpp"
+
+namespace stm32::f4
+{
+	/**
+	 * @brief Set of clock profiles the system can switch between at runtime.
+	 *
+	 * Every profile is a complete clock_tree, so PLL dividers, regulator
+	 * scale, over-drive and bus prescalers are still computed at compile
+	 * time. Switching programs the flash latency in the safe order (raised
+	 * before, lowered after the frequency change), runs the clock tree
+	 * initialisation and updates SystemCoreClock. An optional listener is
+	 * notified afterwards, e.g. to reload the RTOS tick or the prescalers of
+	 * µs timers (see bsp::nucleo_f446ze::retune_timers()).
+	 *
+	 * Example:
+	 * @code
+	 * using profiles = board::clock_profiles<24 * MHz, 84 * MHz, 180 * MHz>;
+	 * profiles::select(2); // burst
+	 * profiles::select(0); // idle
+	 * @endcode
+	 *
+	 * @note The system clock temporarily runs from HSI/HSE while the PLL
+	 *       relocks. Interrupts stay enabled; select() must not be called
+	 *       from interrupt handlers.
+	 *
+	 * @tparam supply_voltage Supply voltage of the device
+	 * @tparam Trees          clock_tree configurations, one per profile
+	 */
+	template <utils::quantity::mv_t supply_voltage, typename... Trees>
+	struct clock_profiles
+	{
+		static_assert(sizeof...(Trees) > 0, "At least one clock profile is required");
+
+		using flash_control = flash<supply_voltage>; //!< Flash latency and ART accelerator
+
+		/**
+		 * @brief Called after every profile switch with the new HCLK frequency.
+		 */
+		using listener = void (*)(utils::quantity::Hz_t hclk) noexcept;
+
+		static constexpr std::size_t count = sizeof...(Trees); //!< Number of profiles
+
+		/**
+		 * @brief HCLK frequency of every profile.
+		 */
+		static constexpr std::array<utils::quantity::Hz_t, count> frequencies{Trees::hclk()...};
+
+		/**
+		 * @brief Clock of the APB1 timers of every profile, e.g. to retune timer prescalers.
+		 */
+		static constexpr std::array<utils::quantity::Hz_t, count> timer_clocks1{Trees::timer_clock1()...};
+
+		/**
+		 * @brief Switch to a profile.
+		 *
+		 * Nothing is done if the profile is already active.
+		 *
+		 * @param index Profile index
+		 * @return true The profile is active.
+		 * @return false @p index is out of range.
+		 */
+		static bool select(std::size_t index) noexcept
+		{
+			if (index >= count)
+			{
+				return false;
+			}
+			if (index != active)
+			{
+				switch_table[index]();
+				changed(index);
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Switch to a profile known at compile time.
+		 *
+		 * @tparam index Profile index
+		 */
+		template <std::size_t index>
+		static void select() noexcept
+		{
+			static_assert(index < count, "Clock profile index out of range");
+			if (index != active)
+			{
+				apply<index>();
+				changed(index);
+			}
+		}
+
+		/**
+		 * @brief Index of the active profile.
+		 *
+		 * @return std::size_t count if no profile was selected yet
+		 */
+		[[nodiscard]]
+		static std::size_t current() noexcept
+		{
+			return active;
+		}
+
+		/**
+		 * @brief Install the listener notified after a profile switch.
+		 *
+		 * @param callback Listener, nullptr to remove it
+		 */
+		static void on_change(listener callback) noexcept
+		{
+			notify = callback;
+		}
+
+	  private:
+		/**
+		 * @brief Reconfigure flash and clock tree for one profile.
+		 *
+		 * Higher latency is always safe, so the latency is raised before and
+		 * lowered after the clock tree is switched. Nothing is reprogrammed
+		 * if the hardware already runs the profile, e.g. after board init.
+		 */
+		template <std::size_t index>
+		static void apply() noexcept
+		{
+			using tree = std::tuple_element_t<index, std::tuple<Trees...>>;
+			constexpr utils::quantity::Hz_t hclk = tree::hclk();
+
+			if (tree::is_configured() && flash_control::template is_configured<hclk>())
+			{
+				return;
+			}
+
+			if (flash_control::latency() < flash_control::wait_states(hclk))
+			{
+				flash_control::template configure<hclk>();
+				tree::init();
+			}
+			else
+			{
+				tree::init();
+				flash_control::template configure<hclk>();
+			}
+		}
+
+		/**
+		 * @brief Record the new profile and notify the listener.
+		 */
+		static void changed(std::size_t index) noexcept
+		{
+			active = index;
+			if (notify != nullptr)
+			{
+				notify(frequencies[index]);
+			}
+		}
+
+		/**
+		 * @brief Table of the apply() instantiations for runtime dispatch.
+		 */
+		template <std::size_t... I>
+		static constexpr std::array<void (*)() noexcept, count> make_table(std::index_sequence<I...>) noexcept
+		{
+			return {&apply<I>...};
+		}
+
+		static constexpr std::array<void (*)() noexcept, count> switch_table =
+			make_table(std::make_index_sequence<count>{}); //!< apply() per profile
+
+		static inline std::size_t active = count;	 //!< Active profile, count if none
+		static inline listener notify = nullptr; //!< Profile switch listener
+	};
+
+} // namespace stm32::f4
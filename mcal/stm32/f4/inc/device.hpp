@@ -0,0 +1,63 @@
+/**
+ * @file device.hpp
+ * @brief STM32F4 device header used by the MCAL drivers.
+ *
+ * Includes the CMSIS device header. Host builds (MCAL_HOST) additionally
+ * redirect the CMSIS peripheral instances (RCC, GPIOA, DWT, ...) onto the
+ * simulated register files via mcal::peripheral().
+ *
+ * @note CMSIS inline functions (NVIC_*, ITM_SendChar, SysTick_Config, ...)
+ *       are expanded before this redirection and must not be used in
+ *       code that is meant to run in host builds.
+ */
+#pragma once
+
+#include "mcal.hpp"
+#include "stm32f4xx.h"
+
+#ifdef MCAL_HOST
+#undef RCC
+#define RCC (::mcal::peripheral<RCC_TypeDef>(RCC_BASE))
+#undef FLASH
+#define FLASH (::mcal::peripheral<FLASH_TypeDef>(FLASH_R_BASE))
+#undef PWR
+#define PWR (::mcal::peripheral<PWR_TypeDef>(PWR_BASE))
+#undef SYSCFG
+#define SYSCFG (::mcal::peripheral<SYSCFG_TypeDef>(SYSCFG_BASE))
+#undef EXTI
+#define EXTI (::mcal::peripheral<EXTI_TypeDef>(EXTI_BASE))
+#undef DBGMCU
+#define DBGMCU (::mcal::peripheral<DBGMCU_TypeDef>(DBGMCU_BASE))
+#undef TIM2
+#define TIM2 (::mcal::peripheral<TIM_TypeDef>(TIM2_BASE))
+#undef TIM5
+#define TIM5 (::mcal::peripheral<TIM_TypeDef>(TIM5_BASE))
+#undef GPIOA
+#define GPIOA (::mcal::peripheral<GPIO_TypeDef>(GPIOA_BASE))
+#undef GPIOB
+#define GPIOB (::mcal::peripheral<GPIO_TypeDef>(GPIOB_BASE))
+#undef GPIOC
+#define GPIOC (::mcal::peripheral<GPIO_TypeDef>(GPIOC_BASE))
+#undef GPIOD
+#define GPIOD (::mcal::peripheral<GPIO_TypeDef>(GPIOD_BASE))
+#undef GPIOE
+#define GPIOE (::mcal::peripheral<GPIO_TypeDef>(GPIOE_BASE))
+#undef GPIOF
+#define GPIOF (::mcal::peripheral<GPIO_TypeDef>(GPIOF_BASE))
+#undef GPIOG
+#define GPIOG (::mcal::peripheral<GPIO_TypeDef>(GPIOG_BASE))
+#undef GPIOH
+#define GPIOH (::mcal::peripheral<GPIO_TypeDef>(GPIOH_BASE))
+#undef SCB
+#define SCB (::mcal::peripheral<SCB_Type>(SCB_BASE))
+#undef SysTick
+#define SysTick (::mcal::peripheral<SysTick_Type>(SysTick_BASE))
+#undef NVIC
+#define NVIC (::mcal::peripheral<NVIC_Type>(NVIC_BASE))
+#undef ITM
+#define ITM (::mcal::peripheral<ITM_Type>(ITM_BASE))
+#undef DWT
+#define DWT (::mcal::peripheral<DWT_Type>(DWT_BASE))
+#undef CoreDebug
+#define CoreDebug (::mcal::peripheral<CoreDebug_Type>(CoreDebug_BASE))
+#endif
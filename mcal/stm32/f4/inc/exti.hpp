@@ -0,0 +1,193 @@
+/**
+ * @file exti.hpp
+ * @brief Interrupt-driven GPIO inputs through the EXTI controller.
+ *
+ * The EXTI interrupt handlers of the vector table (see src/exti.cpp)
+ * dispatch every pending line to the handler bound with ExtiPin::init().
+ * ExtiPin only routes the pin, the NVIC priority and enable of its
+ * interrupt are set by the interrupt registry (see interrupt.hpp).
+ *
+ * Example:
+ * @code
+ * using Button = stm32::f4::ExtiPin<board::B1, stm32::f4::ExtiEdge::Both>;
+ * using interrupts = stm32::f4::InterruptTable<stm32::f4::VectorTable::Flash, Button>;
+ * interrupts::init();
+ * Button::init([](void *) noexcept { board::LD_Blue::toggle(); });
+ * @endcode
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "mcal.hpp"
+
+#include "device.hpp"
+
+namespace stm32::f4
+{
+	/**
+	 * @brief Edges triggering an EXTI interrupt.
+	 */
+	enum class ExtiEdge
+	{
+		Rising,	 //!< Low to high transition
+		Falling, //!< High to low transition
+		Both,	 //!< Any transition
+	};
+
+	/**
+	 * @brief EXTI line handler, called in interrupt context.
+	 */
+	using exti_handler = void (*)(void *context) noexcept;
+
+	/**
+	 * @brief Handler and its argument bound to one EXTI line.
+	 */
+	struct exti_binding
+	{
+		exti_handler callback = nullptr; //!< Called when the line fires
+		void *context = nullptr;		 //!< Passed to the callback
+	};
+
+	/**
+	 * @brief EXTI line handler table and dispatcher.
+	 */
+	struct exti
+	{
+		using handler = exti_handler; //!< Line handler, called in interrupt context
+		using binding = exti_binding; //!< Handler and its argument bound to one line
+
+		static constexpr std::uint8_t lines = 16; //!< GPIO lines
+
+		/**
+		 * @brief Interrupt shared by a line.
+		 */
+		static constexpr IRQn_Type irq_of(std::uint8_t line) noexcept
+		{
+			if (line < 5)
+			{
+				return static_cast<IRQn_Type>(EXTI0_IRQn + line);
+			}
+			return line < 10 ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+		}
+
+		/**
+		 * @brief Clear and dispatch the pending lines of one interrupt.
+		 *
+		 * @tparam first First line of the interrupt
+		 * @tparam last  Last line of the interrupt
+		 */
+		template <std::uint8_t first, std::uint8_t last>
+		[[gnu::always_inline]]
+		static inline void dispatch() noexcept
+		{
+			constexpr std::uint32_t mask = ((2u << last) - 1u) & ~((1u << first) - 1u);
+
+			const std::uint32_t pending = Register::read(EXTI->PR, mask) & Register::read(EXTI->IMR);
+			Register::store(EXTI->PR, pending); // write 1 to clear
+
+			for (std::uint32_t rest = pending; rest != 0; rest &= rest - 1u)
+			{
+				const binding &bound = bindings[static_cast<std::size_t>(std::countr_zero(rest))];
+				if (bound.callback != nullptr)
+				{
+					bound.callback(bound.context);
+				}
+			}
+		}
+
+		static inline std::array<binding, lines> bindings{}; //!< Handler per line
+	};
+
+	/**
+	 * @brief NVIC priority of an EXTI interrupt, the default of ExtiPin.
+	 *
+	 * Lines 5..9 (EXTI9_5) and 10..15 (EXTI15_10) share one interrupt each,
+	 * so every pin on them has to use this priority. Specialise it once
+	 * per application to change it:
+	 * @code
+	 * template <>
+	 * inline constexpr std::uint8_t stm32::f4::exti_priority<EXTI15_10_IRQn> = 6;
+	 * @endcode
+	 */
+	template <IRQn_Type Irq>
+	inline constexpr std::uint8_t exti_priority = 15;
+
+	/**
+	 * @brief EXTI binding of a GpioPin.
+	 *
+	 * Name it in the InterruptTable of the application, which sets the
+	 * NVIC priority and enables the interrupt. Pins on the shared
+	 * interrupts EXTI9_5 and EXTI15_10 must use exti_priority of their
+	 * interrupt.
+	 *
+	 * @tparam Pin      Input pin (GpioPin)
+	 * @tparam Edge     Triggering edges
+	 * @tparam Priority NVIC priority, 0 is the most urgent
+	 */
+	template <typename Pin, ExtiEdge Edge, std::uint8_t Priority = exti_priority<exti::irq_of(Pin::pin)>>
+	struct ExtiPin
+	{
+		static constexpr std::uint8_t line = Pin::pin;			 //!< EXTI line, equals the pin number
+		static constexpr IRQn_Type irq = exti::irq_of(line);	 //!< Interrupt serving the line
+		static constexpr std::uint8_t priority = Priority;		 //!< NVIC priority
+		static constexpr std::uint32_t mask = 1u << line;		 //!< Line bit in the EXTI registers
+		static constexpr std::uint32_t shift = (line % 4u) * 4u; //!< Port field in SYSCFG->EXTICR
+		static constexpr std::uint32_t port = Pin::port::index;	 //!< Port routed to the line
+
+		static_assert((irq != EXTI9_5_IRQn && irq != EXTI15_10_IRQn) || Priority == exti_priority<irq>,
+					  "Pins on EXTI9_5 and EXTI15_10 share the interrupt, use exti_priority of the interrupt");
+
+		/**
+		 * @brief Route the pin to its EXTI line, select the edges and unmask the line.
+		 *
+		 * The pin itself must be configured as input (see GpioConfig). The
+		 * NVIC is left to the interrupt registry, so a pending interrupt of
+		 * the line is not lost between both.
+		 *
+		 * @param callback Handler called on every selected edge
+		 * @param context  Argument passed to @p callback
+		 */
+		static void init(exti::handler callback, void *context = nullptr) noexcept
+		{
+			// Mask the line while it is rerouted
+			disable();
+			exti::bindings[line] = {callback, context};
+
+			Register::set(RCC->APB2ENR, RCC_APB2ENR_SYSCFGEN);
+			Register::write<port << shift, 0xFu << shift>(SYSCFG->EXTICR[line / 4u]);
+
+			if constexpr (Edge == ExtiEdge::Rising || Edge == ExtiEdge::Both)
+				Register::set(EXTI->RTSR, mask);
+			else
+				Register::clear(EXTI->RTSR, mask);
+			if constexpr (Edge == ExtiEdge::Falling || Edge == ExtiEdge::Both)
+				Register::set(EXTI->FTSR, mask);
+			else
+				Register::clear(EXTI->FTSR, mask);
+
+			Register::store(EXTI->PR, mask);
+			enable();
+		}
+
+		/**
+		 * @brief Unmask the line.
+		 */
+		static void enable() noexcept
+		{
+			Register::set(EXTI->IMR, mask);
+		}
+
+		/**
+		 * @brief Mask the line, edges are no longer reported.
+		 */
+		static void disable() noexcept
+		{
+			Register::clear(EXTI->IMR, mask);
+		}
+	};
+
+} // namespace stm32::f4
@@ -1,5 +1,15 @@
 #pragma once
 #include "clock.hpp"
+#include "clock_profiles.hpp"
+#include "exti.hpp"
+#include "flash.hpp"
 #include "gpio.hpp"
+#include "interrupt.hpp"
+#include "itm.hpp"
 #include "mcal.hpp"
+#include "nvic.hpp"
+#include "profile.hpp"
+#include "sections.hpp"
+#include "timebase.hpp"
+#include "timer.hpp"
 #include "utils.hpp"
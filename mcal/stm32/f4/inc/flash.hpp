@@ -0,0 +1,164 @@
+/**
+ * @file flash.hpp
+ * @brief STM32F4 embedded flash interface and ART accelerator control.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "mcal.hpp"
+#include "device.hpp"
+#include "stm32f446_svd.hpp"
+
+#include "units.hpp"
+
+namespace stm32::f4
+{
+	/**
+	 * @brief Flash access control (FLASH_ACR) for a given supply voltage.
+	 *
+	 * Computes the number of wait states from the supply voltage and the
+	 * HCLK frequency (RM0390, Table 5) and enables the ART accelerator:
+	 * prefetch, instruction cache and data cache. With the ART enabled,
+	 * code executed from flash runs close to zero wait states even at
+	 * 180 MHz.
+	 *
+	 * The latency has to be raised before HCLK is increased and may only
+	 * be lowered after HCLK was decreased.
+	 *
+	 * FLASH_ACR is accessed through the register map generated from the
+	 * SVD file, so writes are checked against reserved and read-only bits.
+	 *
+	 * @tparam supply_voltage Supply voltage of the device
+	 */
+	template <utils::quantity::mv_t supply_voltage>
+	struct flash
+	{
+		static_assert(supply_voltage >= 1800 * utils::unit::mV && supply_voltage <= 3600 * utils::unit::mV,
+					  "STM32F4 supply voltage must be within 1.8 V ... 3.6 V");
+
+		using ACR = svd::flash::ACR::reg;		  //!< Access control register
+		using LATENCY = svd::flash::ACR::LATENCY; //!< Wait states
+		using PRFTEN = svd::flash::ACR::PRFTEN;	  //!< Prefetch enable
+		using ICEN = svd::flash::ACR::ICEN;		  //!< Instruction cache enable
+		using DCEN = svd::flash::ACR::DCEN;		  //!< Data cache enable
+		using ICRST = svd::flash::ACR::ICRST;	  //!< Instruction cache reset
+		using DCRST = svd::flash::ACR::DCRST;	  //!< Data cache reset
+
+		/**
+		 * @brief HCLK range covered by one wait state.
+		 *
+		 * @return constexpr utils::quantity::Hz_t step per wait state
+		 */
+		static constexpr utils::quantity::Hz_t wait_state_step() noexcept
+		{
+			if (supply_voltage >= 2700 * utils::unit::mV)
+				return 30 * utils::unit::MHz;
+			if (supply_voltage >= 2400 * utils::unit::mV)
+				return 24 * utils::unit::MHz;
+			if (supply_voltage >= 2100 * utils::unit::mV)
+				return 22 * utils::unit::MHz;
+			return 20 * utils::unit::MHz;
+		}
+
+		/**
+		 * @brief Highest HCLK frequency allowed at the supply voltage.
+		 *
+		 * @return constexpr utils::quantity::Hz_t maximum HCLK
+		 */
+		static constexpr utils::quantity::Hz_t max_frequency() noexcept
+		{
+			return (supply_voltage >= 2100 * utils::unit::mV) ? 180 * utils::unit::MHz : 168 * utils::unit::MHz;
+		}
+
+		/**
+		 * @brief Prefetch must stay disabled below 2.1 V (RM0390, Table 5).
+		 */
+		static constexpr bool prefetch = supply_voltage >= 2100 * utils::unit::mV;
+
+		/**
+		 * @brief Number of wait states required for a HCLK frequency.
+		 *
+		 * @param hclk AHB clock frequency
+		 * @return constexpr std::uint32_t wait states (LATENCY field value)
+		 */
+		static constexpr std::uint32_t wait_states(utils::quantity::Hz_t hclk) noexcept
+		{
+			const std::uint32_t f = hclk.numerical_value_in(utils::unit::Hz);
+			const std::uint32_t step = wait_state_step().numerical_value_in(utils::unit::Hz);
+			return (f == 0) ? 0 : (f - 1) / step;
+		}
+
+		/**
+		 * @brief Set the number of wait states.
+		 *
+		 * Waits until the new latency is taken over, as required before the
+		 * clock frequency is raised. ART settings are not touched.
+		 *
+		 * @param ws Wait states
+		 */
+		static void set_latency(std::uint32_t ws) noexcept
+		{
+			ACR::modify(LATENCY::make(ws));
+			while (LATENCY::read() != ws)
+			{
+			}
+		}
+
+		/**
+		 * @brief Current number of wait states.
+		 *
+		 * @return std::uint32_t wait states
+		 */
+		[[nodiscard]]
+		static std::uint32_t latency() noexcept
+		{
+			return LATENCY::read();
+		}
+
+		/**
+		 * @brief Configure latency and the ART accelerator for a HCLK frequency.
+		 *
+		 * Caches are disabled and reset before they are enabled again, so no
+		 * stale lines survive a reconfiguration.
+		 *
+		 * @tparam hclk AHB clock frequency the flash is configured for
+		 */
+		template <utils::quantity::Hz_t hclk>
+		static void configure() noexcept
+		{
+			static_assert(hclk <= max_frequency(), "HCLK exceeds the maximum frequency at this supply voltage");
+
+			constexpr std::uint32_t ws = wait_states(hclk);
+			constexpr RegisterValue latency = LATENCY::template value<ws>();
+			constexpr RegisterValue art =
+				ICEN::template value<1>() | DCEN::template value<1>() | PRFTEN::template value<prefetch>();
+
+			ACR::template store<latency>();
+			while (LATENCY::read() != ws)
+			{
+			}
+			ACR::template store<latency, ICRST::template value<1>(), DCRST::template value<1>()>();
+			ACR::template store<latency>();
+			ACR::template store<latency, art>();
+		}
+
+		/**
+		 * @brief Check whether latency and ART already match a HCLK frequency.
+		 *
+		 * @tparam hclk AHB clock frequency
+		 * @return true FLASH_ACR is configured for @p hclk.
+		 * @return false FLASH_ACR has to be configured.
+		 */
+		template <utils::quantity::Hz_t hclk>
+		[[nodiscard]]
+		static bool is_configured() noexcept
+		{
+			constexpr RegisterValue expected = LATENCY::template value<wait_states(hclk)>() | ICEN::template value<1>() |
+											   DCEN::template value<1>() | PRFTEN::template value<prefetch>();
+			return Register::read(ACR::ref(), expected.mask) == expected.value;
+		}
+	};
+
+} // namespace stm32::f4
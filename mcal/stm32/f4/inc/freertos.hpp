@@ -0,0 +1,59 @@
+/**
+ * @file freertos.hpp
+ * @brief FreeRTOS task notification from MCAL interrupt sources.
+ *
+ * Only for projects linking the FreeRTOS kernel, not included by f4.hpp.
+ *
+ * Example:
+ * @code
+ * using Button = stm32::f4::ExtiPin<board::B1, stm32::f4::ExtiEdge::Both>;
+ * using interrupts = stm32::f4::InterruptTable<stm32::f4::VectorTable::Flash, Button>;
+ * interrupts::init(); // in main(), before vTaskStartScheduler()
+ * ...
+ * stm32::f4::notify_on<Button>(xTaskGetCurrentTaskHandle());
+ * ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // wakes on every edge
+ * @endcode
+ */
+
+#pragma once
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "exti.hpp"
+
+namespace stm32::f4
+{
+	/**
+	 * @brief Give a task notification from an interrupt handler.
+	 *
+	 * Switches to the task on exit of the handler if it has a higher
+	 * priority than the interrupted one.
+	 *
+	 * @param task TaskHandle_t of the task to notify
+	 */
+	inline void notify_from_isr(void *task) noexcept
+	{
+		BaseType_t woken = pdFALSE;
+		vTaskNotifyGiveFromISR(static_cast<TaskHandle_t>(task), &woken);
+		portYIELD_FROM_ISR(woken);
+	}
+
+	/**
+	 * @brief Notify a task on every edge of an EXTI pin.
+	 *
+	 * Call once the scheduler runs, e.g. from the notified task itself.
+	 * The interrupt of the pin is enabled by the InterruptTable naming it.
+	 *
+	 * @tparam Exti ExtiPin binding, its priority must allow FreeRTOS API calls
+	 * @param task  Task waiting with ulTaskNotifyTake()
+	 */
+	template <typename Exti>
+	void notify_on(TaskHandle_t task) noexcept
+	{
+		static_assert((Exti::priority << (8 - configPRIO_BITS)) >= configMAX_SYSCALL_INTERRUPT_PRIORITY,
+					  "Interrupt priority too urgent for FreeRTOS API calls");
+		Exti::init(notify_from_isr, task);
+	}
+
+} // namespace stm32::f4
@@ -12,12 +12,73 @@
  * at compile time.
  */
 #pragma once
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
 #include "mcal.hpp"
-#include "stm32f4xx.h"
+#include "device.hpp"
 namespace stm32::f4
 {
 	using namespace mcal::concepts;
 
+	/**
+	 * @brief Masked register values for the configuration registers of one port.
+	 *
+	 * Holds the staged bits of MODER, OTYPER, OSPEEDR and PUPDR.
+	 * Configurations of several pins on the same port are merged with
+	 * operator|, so the whole port can be configured with one masked
+	 * write per register.
+	 */
+	struct GpioPortConfig
+	{
+		RegisterValue moder{};	 //!< Staged MODER bits
+		RegisterValue otyper{};	 //!< Staged OTYPER bits
+		RegisterValue ospeedr{}; //!< Staged OSPEEDR bits
+		RegisterValue pupdr{};	 //!< Staged PUPDR bits
+
+		/**
+		 * @brief Compute the configuration of a single pin.
+		 *
+		 * Output type and speed are only applied to output pins.
+		 *
+		 * @param pin   GPIO pin number (0‑15)
+		 * @param mode  Pin mode
+		 * @param type  Output driver type
+		 * @param speed Output slew rate
+		 * @param pull  Pull resistor
+		 * @return Masked register values for this pin
+		 */
+		static constexpr GpioPortConfig make(uint8_t pin, GpioPinMode mode, GpioOutputType type, GpioSpeed speed,
+											 GpioPull pull) noexcept
+		{
+			GpioPortConfig cfg{};
+			const uint32_t shift = pin * 2u;
+
+			cfg.moder = {(mode == GpioPinMode::Output ? 0b01u : 0b00u) << shift, 0b11u << shift};
+
+			if (mode == GpioPinMode::Output)
+			{
+				cfg.otyper = {(type == GpioOutputType::OpenDrain ? 1u : 0u) << pin, 1u << pin};
+				cfg.ospeedr = {static_cast<uint32_t>(speed) << shift, 0b11u << shift};
+			}
+
+			cfg.pupdr = {(pull == GpioPull::Up ? 0b01u : pull == GpioPull::Down ? 0b10u : 0b00u) << shift,
+						 0b11u << shift};
+			return cfg;
+		}
+
+		/**
+		 * @brief Merge two configurations of the same port.
+		 */
+		constexpr GpioPortConfig operator|(const GpioPortConfig &other) const noexcept
+		{
+			return {moder | other.moder, otyper | other.otyper, ospeedr | other.ospeedr, pupdr | other.pupdr};
+		}
+	};
+
 	/**
 	 * @brief Generic GPIO port implementation for STM32F4 series.
 	 *
@@ -28,8 +89,6 @@ namespace stm32::f4
 	 *
 	 * @tparam GPIO_BASE              Base address of the GPIO peripheral.
 	 * @tparam RCC_AHB1ENR_GPIOxEN    Bit mask enabling the GPIO clock in RCC->AHB1ENR.
-	 *
-	 *  @todo We need a Toggle function.
 	 */
 	template <uint32_t GPIO_BASE, uint32_t RCC_AHB1ENR_GPIOxEN>
 	struct GpioImpl
@@ -38,20 +97,30 @@ namespace stm32::f4
 		/**
 		 * @brief Get a typed pointer to the GPIO peripheral.
 		 */
-		static constexpr GPIO_TypeDef *gpio()
+		static GPIO_TypeDef *gpio()
 		{
-			return reinterpret_cast<GPIO_TypeDef *>(GPIO_BASE);
+			return mcal::peripheral<GPIO_TypeDef>(GPIO_BASE);
 		}
 
 		/**
 		 * @brief Get a typed pointer to the RCC peripheral.
 		 */
-		static constexpr RCC_TypeDef *rcc()
+		static RCC_TypeDef *rcc()
 		{
-			return reinterpret_cast<RCC_TypeDef *>(RCC_BASE);
+			return mcal::peripheral<RCC_TypeDef>(RCC_BASE);
 		}
 
 	  public:
+		/**
+		 * @brief Bit enabling the clock of this port in RCC->AHB1ENR.
+		 */
+		static constexpr uint32_t clock_enable_mask = RCC_AHB1ENR_GPIOxEN;
+
+		/**
+		 * @brief Port index (A = 0, B = 1, ...) as used by SYSCFG->EXTICR.
+		 */
+		static constexpr uint8_t index = static_cast<uint8_t>(std::countr_zero(RCC_AHB1ENR_GPIOxEN));
+
 		/**
 		 * @brief Enable the clock for this GPIO port.
 		 */
@@ -91,34 +160,68 @@ namespace stm32::f4
 			}
 		}
 
+		/**
+		 * @brief Apply a merged pin configuration to the port
+		 *
+		 * Performs at most one masked write per configuration register.
+		 * Registers without affected bits are not accessed at all.
+		 *
+		 * @tparam cfg Merged configuration of all pins to be set up
+		 */
+		template <GpioPortConfig cfg>
+		static void configure()
+		{
+			Register::modify<cfg.moder>(gpio()->MODER);
+			Register::modify<cfg.otyper>(gpio()->OTYPER);
+			Register::modify<cfg.ospeedr>(gpio()->OSPEEDR);
+			Register::modify<cfg.pupdr>(gpio()->PUPDR);
+		}
+
 		/**
 		 * @brief Write high to pin
 		 *
-		 * Use the ODR register to set the pin high.
+		 * Uses the BSRR set half, so the pin changes with a single store
+		 * and without disturbing other pins driven from an ISR.
 		 *
 		 * @tparam pin
-		 * @todo use BSRR register instead
 		 */
 		template <uint8_t pin>
 		static void writeHigh()
 		{
 			static_assert(pin < 16, "GPIO pin index must be < 16");
-			Register::set(gpio()->ODR, (1 << pin));
+			Register::store(gpio()->BSRR, (1u << pin));
 		}
 
 		/**
 		 * @brief Write low to pin
 		 *
-		 * Use the ODR register to set the pin high.
+		 * Uses the BSRR reset half, so the pin changes with a single store
+		 * and without disturbing other pins driven from an ISR.
 		 *
 		 * @tparam pin
-		 * @todo use BSRR register instead
 		 */
 		template <uint8_t pin>
 		static void writeLow()
 		{
 			static_assert(pin < 16, "GPIO pin index must be < 16");
-			Register::clear(gpio()->ODR, (1 << pin));
+			Register::store(gpio()->BSRR, (1u << (pin + 16)));
+		}
+
+		/**
+		 * @brief Toggle pin
+		 *
+		 * Reads the pin from ODR and writes the inverted level through BSRR.
+		 * Other pins of the port are never written.
+		 *
+		 * @tparam pin
+		 */
+		template <uint8_t pin>
+		static void toggle()
+		{
+			static_assert(pin < 16, "GPIO pin index must be < 16");
+			constexpr uint32_t mask = 1u << pin;
+			const uint32_t odr = Register::read(gpio()->ODR, mask);
+			Register::store(gpio()->BSRR, (odr << 16) | (odr ^ mask));
 		}
 
 		/**
@@ -134,8 +237,62 @@ namespace stm32::f4
 			static_assert(pin < 16, "GPIO pin index must be < 16");
 			return Register::read(gpio()->IDR, (1 << pin));
 		}
+
+		/**
+		 * @brief Write high to all pins selected by a mask
+		 *
+		 * @tparam mask Pins to be set (bit n = pin n)
+		 */
+		template <uint16_t mask>
+		static void writeHighMask()
+		{
+			Register::store(gpio()->BSRR, mask);
+		}
+
+		/**
+		 * @brief Write low to all pins selected by a mask
+		 *
+		 * @tparam mask Pins to be cleared (bit n = pin n)
+		 */
+		template <uint16_t mask>
+		static void writeLowMask()
+		{
+			Register::store(gpio()->BSRR, static_cast<uint32_t>(mask) << 16);
+		}
+
+		/**
+		 * @brief Write a value to all pins selected by a mask
+		 *
+		 * Set and reset bits are combined into one BSRR store, so all
+		 * selected pins change at the same instant.
+		 *
+		 * @tparam mask Pins to be written (bit n = pin n)
+		 * @param value Port value; bits outside of @p mask are ignored
+		 */
+		template <uint16_t mask>
+		static void writeMask(uint16_t value)
+		{
+			const uint32_t high = value & mask;
+			const uint32_t low = ~value & mask;
+			Register::store(gpio()->BSRR, (low << 16) | high);
+		}
+
+		/**
+		 * @brief Read all pins selected by a mask
+		 *
+		 * @tparam mask Pins to be read (bit n = pin n)
+		 * @return Port input value, masked by @p mask
+		 */
+		template <uint16_t mask>
+		static uint16_t readMask()
+		{
+			return static_cast<uint16_t>(Register::read(gpio()->IDR, mask));
+		}
 	};
 
+	template <typename... Pins>
+	struct GpioConfig;
+
 	/**
 	 * @brief High‑level GPIO pin abstraction for STM32F4 series.
 	 *
@@ -146,21 +303,33 @@ namespace stm32::f4
 	 * @tparam Port   GPIO port type conforming to GpioPort concept.
 	 * @tparam Pin    GPIO pin number (0‑15).
 	 * @tparam Mode   GPIO pin mode (Input/Output).
-	 *
-	 * @todo We need a Toggle function.
+	 * @tparam Type   Output driver type (outputs only).
+	 * @tparam Speed  Output slew rate (outputs only).
+	 * @tparam Pull   Pull resistor configuration.
 	 */
-	template <GpioPort Port, uint8_t Pin, GpioPinMode Mode = GpioPinMode::Input>
+	template <GpioPort Port, uint8_t Pin, GpioPinMode Mode = GpioPinMode::Input,
+			  GpioOutputType Type = GpioOutputType::PushPull, GpioSpeed Speed = GpioSpeed::Low,
+			  GpioPull Pull = GpioPull::None>
 	struct GpioPin
 	{
+		static_assert(Pin < 16, "GPIO pin index must be < 16");
+
+		using port = Port;				   //!< GPIO port of this pin
+		static constexpr uint8_t pin = Pin; //!< GPIO pin number
+
+		/**
+		 * @brief Register configuration of this pin.
+		 */
+		static constexpr GpioPortConfig config = GpioPortConfig::make(Pin, Mode, Type, Speed, Pull);
+
 		/**
 		 * @brief Initialize the GPIO pin.
 		 *
+		 * Use GpioConfig to initialize several pins at once.
 		 */
-		static_assert(Pin < 16, "GPIO pin index must be < 16");
 		static void init()
 		{
-			Port::enable();
-			Port::template setMode<Pin, Mode>();
+			GpioConfig<GpioPin>::init();
 		}
 
 		/**
@@ -180,6 +349,16 @@ namespace stm32::f4
 		{
 			Port::template writeLow<Pin>();
 		}
+
+		/**
+		 * @brief Toggle the GPIO pin.
+		 *
+		 */
+		static void toggle()
+		{
+			Port::template toggle<Pin>();
+		}
+
 		/**
 		 * @brief Read the GPIO pin state.
 		 *
@@ -192,6 +371,243 @@ namespace stm32::f4
 		}
 	};
 
+	/**
+	 * @brief Group of pins on one GPIO port accessed as a single value.
+	 *
+	 * All pins are written with one BSRR store and read with one IDR load.
+	 * Bit i of the packed value corresponds to the i-th entry of @p Pins,
+	 * so the first pin listed is the least significant bit.
+	 *
+	 * Example:
+	 * @code
+	 * using Bus = GpioPortMask<GpioD, 0, 1, 2, 3, 4, 5, 6, 7>;
+	 * Bus::write(0xA5); // PD0..PD7 change at the same instant
+	 * @endcode
+	 *
+	 * @tparam Port   GPIO port type conforming to GpioPort concept.
+	 * @tparam Pins   GPIO pin numbers (0‑15), each at most once.
+	 */
+	template <GpioPort Port, uint8_t... Pins>
+	struct GpioPortMask
+	{
+		static_assert(sizeof...(Pins) > 0, "GpioPortMask needs at least one pin");
+		static_assert(((Pins < 16) && ...), "GPIO pin index must be < 16");
+
+		/**
+		 * @brief Port bit mask covering all pins of the group.
+		 */
+		static constexpr uint16_t mask = static_cast<uint16_t>((0u | ... | (1u << Pins)));
+
+		static_assert(std::popcount(mask) == sizeof...(Pins), "GPIO pin listed more than once");
+
+		/**
+		 * @brief Number of pins in the group.
+		 */
+		static constexpr uint8_t width = sizeof...(Pins);
+
+		/**
+		 * @brief Pin order as listed, used to pack and unpack values.
+		 */
+		static constexpr uint8_t pins[] = {Pins...};
+
+		/**
+		 * @brief Pins are listed ascending without gaps.
+		 *
+		 * Packing then reduces to a single shift.
+		 */
+		static constexpr bool contiguous = []() {
+			for (uint8_t i = 1; i < width; ++i)
+			{
+				if (pins[i] != pins[0] + i)
+					return false;
+			}
+			return true;
+		}();
+
+		/**
+		 * @brief Spread a packed value onto its port bit positions.
+		 *
+		 * @param value Packed value (bit i = i-th pin)
+		 * @return Port value (bit n = pin n)
+		 */
+		static constexpr uint16_t scatter(uint16_t value) noexcept
+		{
+			if constexpr (contiguous)
+			{
+				return static_cast<uint16_t>((static_cast<uint32_t>(value) << pins[0]) & mask);
+			}
+			else
+			{
+				uint32_t port = 0;
+				for (uint8_t i = 0; i < width; ++i)
+				{
+					port |= ((value >> i) & 1u) << pins[i];
+				}
+				return static_cast<uint16_t>(port);
+			}
+		}
+
+		/**
+		 * @brief Collect port bits into a packed value.
+		 *
+		 * @param port Port value (bit n = pin n)
+		 * @return Packed value (bit i = i-th pin)
+		 */
+		static constexpr uint16_t gather(uint16_t port) noexcept
+		{
+			if constexpr (contiguous)
+			{
+				return static_cast<uint16_t>((port & mask) >> pins[0]);
+			}
+			else
+			{
+				uint32_t value = 0;
+				for (uint8_t i = 0; i < width; ++i)
+				{
+					value |= ((port >> pins[i]) & 1u) << i;
+				}
+				return static_cast<uint16_t>(value);
+			}
+		}
+
+		/**
+		 * @brief Set all pins of the group high.
+		 *
+		 */
+		static void set()
+		{
+			Port::template writeHighMask<mask>();
+		}
+
+		/**
+		 * @brief Clear all pins of the group low.
+		 *
+		 */
+		static void clear()
+		{
+			Port::template writeLowMask<mask>();
+		}
+
+		/**
+		 * @brief Write a packed value to the group.
+		 *
+		 * @param value Packed value (bit i = i-th pin); surplus bits are ignored
+		 */
+		static void write(uint16_t value)
+		{
+			Port::template writeMask<mask>(scatter(value));
+		}
+
+		/**
+		 * @brief Read the group as a packed value.
+		 *
+		 * @return Packed value (bit i = i-th pin)
+		 */
+		static uint16_t read()
+		{
+			return gather(Port::template readMask<mask>());
+		}
+	};
+
+	/**
+	 * @brief Coalesced initialization of a set of GPIO pins.
+	 *
+	 * Groups all pins by port at compile time. init() enables the clocks
+	 * of all involved ports with a single AHB1ENR update and then performs
+	 * one masked write per configuration register and port, regardless of
+	 * how many pins share that port.
+	 *
+	 * Example:
+	 * @code
+	 * using Pins = GpioConfig<LD_Green, LD_Blue, LD_Red, B1>;
+	 * Pins::init(); // GPIOB and GPIOC: 1x AHB1ENR, 4 writes per port
+	 * @endcode
+	 *
+	 * @tparam Pins GpioPin types to be initialized.
+	 */
+	template <typename... Pins>
+	struct GpioConfig
+	{
+	  private:
+		/**
+		 * @brief Port of the pin at a given position.
+		 */
+		template <std::size_t I>
+		using port_at = std::tuple_element_t<I, std::tuple<typename Pins::port...>>;
+
+		/**
+		 * @brief Check whether the pin at position I is the first one on its port.
+		 */
+		template <std::size_t I>
+		static constexpr bool first_on_port()
+		{
+			return []<std::size_t... J>(std::index_sequence<J...>) {
+				return !(std::same_as<port_at<J>, port_at<I>> || ...);
+			}(std::make_index_sequence<I>{});
+		}
+
+		/**
+		 * @brief Merged configuration of all pins on a port.
+		 */
+		template <typename Port>
+		static constexpr GpioPortConfig config_of()
+		{
+			GpioPortConfig cfg{};
+			((cfg = std::same_as<typename Pins::port, Port> ? (cfg | Pins::config) : cfg), ...);
+			return cfg;
+		}
+
+		/**
+		 * @brief Pin mask of all pins on a port.
+		 */
+		template <typename Port>
+		static constexpr uint32_t pins_of()
+		{
+			return (0u | ... | (std::same_as<typename Pins::port, Port> ? (1u << Pins::pin) : 0u));
+		}
+
+		/**
+		 * @brief Number of pins listed for a port.
+		 */
+		template <typename Port>
+		static constexpr int count_of()
+		{
+			return (0 + ... + (std::same_as<typename Pins::port, Port> ? 1 : 0));
+		}
+
+		/**
+		 * @brief Configure the port of pin I, if pin I is the first one on it.
+		 */
+		template <std::size_t I>
+		static void configure_port()
+		{
+			if constexpr (first_on_port<I>())
+			{
+				using Port = port_at<I>;
+				static_assert(std::popcount(pins_of<Port>()) == count_of<Port>(), "GPIO pin listed more than once");
+				Port::template configure<config_of<Port>()>();
+			}
+		}
+
+	  public:
+		/**
+		 * @brief Clock enable bits of all involved ports.
+		 */
+		static constexpr uint32_t clock_enable_mask = (0u | ... | Pins::port::clock_enable_mask);
+
+		/**
+		 * @brief Enable all port clocks and configure all pins.
+		 *
+		 */
+		static void init()
+		{
+			Register::set(RCC->AHB1ENR, clock_enable_mask);
+			[]<std::size_t... I>(std::index_sequence<I...>) {
+				(configure_port<I>(), ...);
+			}(std::index_sequence_for<Pins...>{});
+		}
+	};
+
 #ifdef GPIOA_BASE
 	using GpioA = GpioImpl<GPIOA_BASE, RCC_AHB1ENR_GPIOAEN>;
 	static_assert(GpioPort<GpioA>);
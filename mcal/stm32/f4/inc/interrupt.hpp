@@ -0,0 +1,347 @@
+/**
+ * @file interrupt.hpp
+ * @brief Compile-time interrupt registry with an optional vector table in SRAM.
+ *
+ * Drivers name their interrupt and handler as a type, the registry checks
+ * all bindings at compile time and configures the NVIC in one batch:
+ * @code
+ * void on_tick() noexcept { ... }
+ * using Button = stm32::f4::ExtiPin<board::B1, stm32::f4::ExtiEdge::Both>;
+ * using Tick = stm32::f4::Interrupt<TIM2_IRQn, on_tick, 3>;
+ *
+ * using interrupts = stm32::f4::InterruptTable<stm32::f4::VectorTable::Sram, Button, Tick>;
+ * interrupts::init();
+ * Button::init(on_button);
+ * @endcode
+ *
+ * Drivers only configure their peripheral, the registry is the only place
+ * writing the NVIC priority and enable bits of a bound interrupt.
+ *
+ * With VectorTable::Sram the flash vector table is copied to SRAM and
+ * VTOR is pointed at the copy, which saves the flash wait states of the
+ * vector fetch on every interrupt entry and allows installing handlers
+ * without defining the extern "C" IRQHandler symbols.
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "mcal.hpp"
+#include "nvic.hpp"
+
+#include "device.hpp"
+
+#ifndef MCAL_HOST
+extern "C" void (*const g_pfnVectors[])(); // flash vector table of startup.cpp
+#endif
+
+namespace stm32::f4
+{
+	/**
+	 * @brief Location of the active vector table.
+	 */
+	enum class VectorTable
+	{
+		Flash, //!< Table of startup.cpp, handlers are the IRQHandler symbols
+		Sram,  //!< Copy in SRAM, handlers can be installed at runtime
+	};
+
+	/**
+	 * @brief Vector table copy in SRAM.
+	 */
+	struct vector_table
+	{
+		using entry = void (*)(); //!< Exception or interrupt handler
+
+		static constexpr std::size_t exceptions = 16;								  //!< Core exceptions before IRQ 0
+		static constexpr std::size_t size = exceptions + FMPI2C1_ER_IRQn + 1;		  //!< Entries of the STM32F446 table
+		static constexpr std::size_t alignment = std::bit_ceil(size * sizeof(entry)); //!< VTOR alignment
+
+		/**
+		 * @brief Check whether the SRAM copy is the active table.
+		 */
+		[[nodiscard]]
+		static bool is_active() noexcept
+		{
+			return Register::load(SCB->VTOR) == address();
+		}
+
+		/**
+		 * @brief Copy the flash table to SRAM and make the copy active.
+		 *
+		 * Does nothing if the copy is already active, so installed handlers
+		 * are kept.
+		 */
+		static void relocate() noexcept
+		{
+			if (is_active())
+			{
+				return;
+			}
+
+#ifndef MCAL_HOST
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				table[i] = g_pfnVectors[i];
+			}
+#endif
+			Register::store(SCB->VTOR, address());
+#ifndef MCAL_HOST
+			__DSB();
+			__ISB();
+#endif
+		}
+
+		/**
+		 * @brief Install the handler of a device interrupt in the SRAM copy.
+		 */
+		template <IRQn_Type irq>
+		static void install(entry handler) noexcept
+		{
+			static_assert(irq >= 0 && exceptions + static_cast<std::size_t>(irq) < size,
+						  "Not a device interrupt of the vector table");
+			table[exceptions + static_cast<std::size_t>(irq)] = handler;
+		}
+
+		alignas(alignment) static inline std::array<entry, size> table{}; //!< Active table once relocated
+
+	  private:
+		static std::uint32_t address() noexcept
+		{
+			return static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(table.data()));
+		}
+	};
+
+	/**
+	 * @brief Interrupt binding of a driver.
+	 *
+	 * @tparam Irq      Device interrupt
+	 * @tparam Handler  Handler installed in the SRAM vector table, nullptr
+	 *                  if the IRQHandler symbol is defined instead
+	 * @tparam Priority NVIC priority, 0 is the most urgent
+	 */
+	template <IRQn_Type Irq, vector_table::entry Handler, std::uint8_t Priority = 15>
+	struct Interrupt
+	{
+		static constexpr IRQn_Type irq = Irq;					//!< Device interrupt
+		static constexpr vector_table::entry handler = Handler;	//!< Bound handler
+		static constexpr std::uint8_t priority = Priority;		//!< NVIC priority
+	};
+
+	namespace detail
+	{
+		/**
+		 * @brief Type naming an interrupt and its priority, e.g. Interrupt or ExtiPin.
+		 */
+		template <typename T>
+		concept interrupt_binding = requires {
+			{ T::irq } -> std::convertible_to<IRQn_Type>;
+			{ T::priority } -> std::convertible_to<std::uint8_t>;
+		};
+
+		struct interrupt_info
+		{
+			std::uint32_t irq;	   //!< Device interrupt
+			std::uint8_t priority; //!< NVIC priority
+			bool handler;		   //!< Binding installs a handler
+		};
+
+		template <interrupt_binding Binding>
+		consteval interrupt_info info_of()
+		{
+			if constexpr (requires { Binding::handler; })
+			{
+				return {static_cast<std::uint32_t>(Binding::irq), Binding::priority, Binding::handler != nullptr};
+			}
+			else
+			{
+				return {static_cast<std::uint32_t>(Binding::irq), Binding::priority, false};
+			}
+		}
+
+		struct priority_word
+		{
+			std::uint32_t index = 0; //!< Word of NVIC->IP[]
+			std::uint32_t value = 0; //!< Priorities in the word
+			std::uint32_t mask = 0;	 //!< Bytes set in the word
+		};
+	} // namespace detail
+
+	/**
+	 * @brief Registry of all interrupt bindings of an application.
+	 *
+	 * Bindings sharing an interrupt (e.g. EXTI lines 5..9) must agree on the
+	 * priority, and only one of them may install a handler. Every binding
+	 * type is listed once.
+	 *
+	 * @tparam Placement Vector table used after init()
+	 * @tparam Bindings  Interrupt bindings (Interrupt, ExtiPin, ...)
+	 */
+	template <VectorTable Placement, detail::interrupt_binding... Bindings>
+	struct InterruptTable
+	{
+		static constexpr std::array<detail::interrupt_info, sizeof...(Bindings)> bindings{
+			detail::info_of<Bindings>()...}; //!< Bound interrupts
+
+		/**
+		 * @brief Check that every binding type is listed once.
+		 *
+		 * A repeated ExtiPin installs no handler, so it would pass
+		 * unique_handlers() unnoticed.
+		 */
+		static consteval bool unique_bindings()
+		{
+			return (... && (occurrences<Bindings>() == 1));
+		}
+
+		/**
+		 * @brief Number of times a binding type is listed.
+		 */
+		template <typename Binding>
+		static consteval std::size_t occurrences()
+		{
+			return (std::size_t{0} + ... + std::is_same_v<Binding, Bindings>);
+		}
+
+		/**
+		 * @brief Check that no interrupt gets two handlers.
+		 */
+		static consteval bool unique_handlers()
+		{
+			for (std::size_t i = 0; i < bindings.size(); ++i)
+			{
+				for (std::size_t j = i + 1; j < bindings.size(); ++j)
+				{
+					if (bindings[i].irq == bindings[j].irq && bindings[i].handler && bindings[j].handler)
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Check that bindings sharing an interrupt agree on the priority.
+		 */
+		static consteval bool consistent_priorities()
+		{
+			for (std::size_t i = 0; i < bindings.size(); ++i)
+			{
+				for (std::size_t j = i + 1; j < bindings.size(); ++j)
+				{
+					if (bindings[i].irq == bindings[j].irq && bindings[i].priority != bindings[j].priority)
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		static_assert(((Bindings::irq >= 0) && ...), "Only device interrupts can be bound");
+		static_assert(((Bindings::priority < (1u << nvic::priority_bits)) && ...), "Interrupt priority out of range");
+		static_assert(unique_bindings(), "Binding listed twice");
+		static_assert(unique_handlers(), "Interrupt bound to two handlers");
+		static_assert(consistent_priorities(), "Bindings of one interrupt use different priorities");
+		static_assert(Placement == VectorTable::Sram || !(detail::info_of<Bindings>().handler || ...),
+					  "Handlers can only be installed with the vector table in SRAM, define the IRQHandler instead");
+
+		/**
+		 * @brief Install the handlers, set all priorities and enable all interrupts.
+		 *
+		 * Pending interrupts are kept: drivers clear stale flags of their
+		 * peripheral in their own init(), so a pending bit is a real event,
+		 * e.g. an edge on an ExtiPin that was initialised first.
+		 */
+		static void init() noexcept
+		{
+			if constexpr (Placement == VectorTable::Sram)
+			{
+				vector_table::relocate();
+				(install<Bindings>(), ...);
+			}
+
+			set_priorities(std::make_index_sequence<priority_word_count>{});
+
+			for (std::size_t i = 0; i < enable_words.size(); ++i)
+			{
+				if (enable_words[i] != 0)
+				{
+					Register::store(NVIC->ISER[i], enable_words[i]);
+				}
+			}
+		}
+
+	  private:
+		static constexpr std::size_t nvic_words = (vector_table::size - vector_table::exceptions + 31u) / 32u;
+
+		/**
+		 * @brief Merge the priorities into the 32 bit words of NVIC->IP[].
+		 */
+		static constexpr auto merge_priorities() noexcept
+		{
+			std::array<detail::priority_word, sizeof...(Bindings)> words{};
+			std::size_t count = 0;
+			for (const detail::interrupt_info &binding : bindings)
+			{
+				const std::uint32_t index = binding.irq / 4u;
+				const std::uint32_t shift = (binding.irq % 4u) * 8u;
+				std::size_t word = 0;
+				while (word < count && words[word].index != index)
+				{
+					++word;
+				}
+				if (word == count)
+				{
+					words[count++].index = index;
+				}
+				words[word].value |= (static_cast<std::uint32_t>(binding.priority) << (8u - nvic::priority_bits))
+									 << shift;
+				words[word].mask |= 0xFFu << shift;
+			}
+			return std::pair{words, count};
+		}
+
+		static constexpr auto priority_words = merge_priorities().first;
+		static constexpr std::size_t priority_word_count = merge_priorities().second;
+
+		static constexpr std::array<std::uint32_t, nvic_words> enable_words = [] {
+			std::array<std::uint32_t, nvic_words> words{};
+			for (const detail::interrupt_info &binding : bindings)
+			{
+				words[binding.irq / 32u] |= 1u << (binding.irq % 32u);
+			}
+			return words;
+		}();
+
+		template <std::size_t... word>
+		static void set_priorities(std::index_sequence<word...>) noexcept
+		{
+			// IP[] is byte accessible, one read-modify-write per word of four priorities
+			auto *ip = reinterpret_cast<volatile std::uint32_t *>(&NVIC->IP[0]);
+			(Register::write<priority_words[word].value, priority_words[word].mask>(ip[priority_words[word].index]),
+			 ...);
+		}
+
+		template <typename Binding>
+		static void install() noexcept
+		{
+			if constexpr (requires { Binding::handler; })
+			{
+				if constexpr (Binding::handler != nullptr)
+				{
+					vector_table::install<Binding::irq>(Binding::handler);
+				}
+			}
+		}
+	};
+
+} // namespace stm32::f4
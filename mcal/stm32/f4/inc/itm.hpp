@@ -0,0 +1,189 @@
+/**
+ * @file itm.hpp
+ * @brief Buffered ITM/SWO output with background draining.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "format.hpp"
+#include "log.hpp"
+#include "mcal.hpp"
+#include "ring_buffer.hpp"
+#include "device.hpp"
+
+namespace stm32::f4
+{
+	/**
+	 * @brief ITM stimulus port output behind a lock-free ring buffer.
+	 *
+	 * write() only copies into the buffer and never waits for the SWO
+	 * FIFO, so it is cheap and safe from any task or interrupt. The data
+	 * is sent by drain(), called from a background context: the RTOS idle
+	 * hook, the idle hook of a sleeping delay (SleepDelayImpl), a main loop
+	 * poll or a low priority timer interrupt. drain()
+	 * uses 32 bit stimulus writes (4 bytes per FIFO slot) and only byte
+	 * writes for the tail of a chunk.
+	 *
+	 * @tparam Capacity Buffer size in bytes, a power of two
+	 * @tparam Policy   Behaviour if the buffer is full
+	 * @tparam Port     ITM stimulus port
+	 */
+	template <std::size_t Capacity, mcal::overflow Policy = mcal::overflow::drop, std::uint32_t Port = 0>
+	struct itm_sink
+	{
+		static_assert(Port < 32, "ITM has 32 stimulus ports");
+
+		/**
+		 * @brief Queue data for output.
+		 *
+		 * @param data Bytes to send
+		 * @return Number of bytes queued, the rest was dropped
+		 */
+		static std::size_t write(std::span<const std::uint8_t> data) noexcept
+		{
+			return buffer.write(data);
+		}
+
+		/**
+		 * @brief Check whether a debugger enabled the stimulus port.
+		 *
+		 * @return true Data written to the port is traced.
+		 * @return false ITM or the port is disabled.
+		 */
+		[[nodiscard]]
+		static bool enabled() noexcept
+		{
+			return Register::read(ITM->TCR, ITM_TCR_ITMENA_Msk) && Register::read(ITM->TER, 1u << Port);
+		}
+
+		/**
+		 * @brief Send queued data as long as the ITM FIFO accepts it.
+		 *
+		 * Never waits. Queued data is discarded while the port is disabled,
+		 * like ITM_SendChar() does. Must only be called from one context.
+		 *
+		 * @return Number of bytes sent
+		 */
+		static std::size_t drain() noexcept
+		{
+			const bool active = enabled();
+			std::size_t sent = 0;
+
+			for (auto chunk = buffer.peek(); !chunk.empty(); chunk = buffer.peek())
+			{
+				std::size_t done = active ? send(chunk) : chunk.size();
+				buffer.consume(done);
+				sent += done;
+				if (done < chunk.size())
+				{
+					break;
+				}
+			}
+			return active ? sent : 0;
+		}
+
+		/**
+		 * @brief Send all queued data, waiting for the ITM FIFO.
+		 */
+		static void flush() noexcept
+		{
+			while (buffer.size() != 0)
+			{
+				drain();
+			}
+		}
+
+		/**
+		 * @brief Number of bytes queued but not sent yet.
+		 */
+		[[nodiscard]]
+		static std::size_t pending() noexcept
+		{
+			return buffer.size();
+		}
+
+		/**
+		 * @brief Number of bytes dropped because the buffer was full.
+		 */
+		[[nodiscard]]
+		static std::uint32_t dropped() noexcept
+		{
+			return buffer.dropped();
+		}
+
+	  private:
+		/**
+		 * @brief Write a chunk to the stimulus port until the FIFO is full.
+		 *
+		 * @return Number of bytes written
+		 */
+		static std::size_t send(std::span<const std::uint8_t> chunk) noexcept
+		{
+			auto &port = ITM->PORT[Port];
+			std::size_t done = 0;
+
+			// Reading a stimulus port returns 1 if the FIFO can take a write
+			while (done < chunk.size() && Register::read(port.u32) != 0)
+			{
+				if (chunk.size() - done >= sizeof(std::uint32_t))
+				{
+					std::uint32_t word;
+					std::memcpy(&word, chunk.data() + done, sizeof(word));
+					Register::store(port.u32, word);
+					done += sizeof(word);
+				}
+				else
+				{
+					port.u8 = chunk[done];
+					done += 1;
+				}
+			}
+			return done;
+		}
+
+		static inline mcal::ring_buffer<Capacity, Policy> buffer{}; //!< Queued output
+	};
+
+	/**
+	 * @brief Default debug output used by printf() (see _write in itm.cpp).
+	 */
+	using itm = itm_sink<1024>;
+
+	/**
+	 * @brief Tokenised log output on stimulus port 1 (see MCAL_LOG).
+	 *
+	 * Frames are dropped as a whole if the buffer is full.
+	 */
+	using log_sink = itm_sink<1024, mcal::overflow::drop, 1>;
+
+	/**
+	 * @brief Print formatted text to the default ITM output.
+	 *
+	 * Format string and argument types are checked at compile time, see
+	 * mcal/inc/format.hpp. The text is queued in one write.
+	 *
+	 * @code
+	 * stm32::f4::print<"SysClk: {:>9}\n">(board::clock::hclk());
+	 * @endcode
+	 */
+	template <mcal::format::string Format, typename... Args>
+	void print(const Args &...args) noexcept
+	{
+		mcal::format::print<itm, Format>(args...);
+	}
+
+} // namespace stm32::f4
+
+/**
+ * @brief Log a tokenised message over ITM port 1, decode with tools/logdecode.py.
+ *
+ * @code
+ * MCAL_LOG("Delay count: %lu\n", loop_counter);
+ * @endcode
+ */
+#define MCAL_LOG(format, ...) MCAL_LOG_TO(::stm32::f4::log_sink, format __VA_OPT__(, ) __VA_ARGS__)
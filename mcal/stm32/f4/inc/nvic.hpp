@@ -0,0 +1,99 @@
+/**
+ * @file nvic.hpp
+ * @brief Nested vectored interrupt controller access for host and target builds.
+ *
+ * Uses the NVIC registers through Register instead of the CMSIS NVIC_*
+ * inline functions, so it also works on the simulated peripherals.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "mcal.hpp"
+
+#include "device.hpp"
+
+namespace stm32::f4
+{
+	/**
+	 * @brief Enable, pend and prioritise device interrupts.
+	 */
+	struct nvic
+	{
+		/**
+		 * @brief Number of implemented priority bits, 0 is the most urgent level.
+		 */
+		static constexpr std::uint32_t priority_bits = __NVIC_PRIO_BITS;
+
+		/**
+		 * @brief Enable an interrupt.
+		 */
+		template <IRQn_Type irq>
+		static void enable() noexcept
+		{
+			Register::store(NVIC->ISER[word<irq>()], bit<irq>());
+		}
+
+		/**
+		 * @brief Disable an interrupt.
+		 */
+		template <IRQn_Type irq>
+		static void disable() noexcept
+		{
+			Register::store(NVIC->ICER[word<irq>()], bit<irq>());
+		}
+
+		/**
+		 * @brief Clear a pending interrupt.
+		 */
+		template <IRQn_Type irq>
+		static void clear_pending() noexcept
+		{
+			Register::store(NVIC->ICPR[word<irq>()], bit<irq>());
+		}
+
+		/**
+		 * @brief Check whether an interrupt is pending.
+		 */
+		template <IRQn_Type irq>
+		[[nodiscard]]
+		static bool is_pending() noexcept
+		{
+			return Register::read(NVIC->ISPR[word<irq>()], bit<irq>()) != 0;
+		}
+
+		/**
+		 * @brief Set the priority of an interrupt.
+		 *
+		 * @tparam irq      Device interrupt
+		 * @tparam priority Priority level, 0 .. 2^priority_bits - 1
+		 */
+		template <IRQn_Type irq, std::uint8_t priority>
+		static void set_priority() noexcept
+		{
+			static_assert(priority < (1u << priority_bits), "Interrupt priority out of range");
+
+			// IP[] is byte accessible, four priorities share one 32 bit word
+			constexpr std::uint32_t shift = (static_cast<std::uint32_t>(irq) % 4u) * 8u;
+			auto *words = reinterpret_cast<volatile std::uint32_t *>(&NVIC->IP[0]);
+			Register::write<(static_cast<std::uint32_t>(priority) << (8u - priority_bits)) << shift, 0xFFu << shift>(
+				words[static_cast<std::uint32_t>(irq) / 4u]);
+		}
+
+	  private:
+		template <IRQn_Type irq>
+		static constexpr std::uint32_t word() noexcept
+		{
+			static_assert(irq >= 0, "Only device interrupts are handled by the NVIC");
+			return static_cast<std::uint32_t>(irq) >> 5;
+		}
+
+		template <IRQn_Type irq>
+		static constexpr std::uint32_t bit() noexcept
+		{
+			return 1u << (static_cast<std::uint32_t>(irq) & 31u);
+		}
+	};
+
+} // namespace stm32::f4
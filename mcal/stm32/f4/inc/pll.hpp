@@ -0,0 +1,221 @@
+/**
+ * @file pll.hpp
+ * @brief Compile time solver for the STM32F4 PLLs (main PLL, PLLI2S, PLLSAI).
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "units.hpp"
+
+namespace stm32::f4
+{
+	/**
+	 * @brief Requested output frequencies of one PLL.
+	 *
+	 * A frequency of zero leaves the output unused.
+	 */
+	struct pll_outputs
+	{
+		utils::quantity::Hz_t P = 0 * utils::unit::Hz; //!< Output P (system clock, SAI, ...)
+		utils::quantity::Hz_t Q = 0 * utils::unit::Hz; //!< Output Q (48 MHz for USB/SDIO, SAI, ...)
+		utils::quantity::Hz_t R = 0 * utils::unit::Hz; //!< Output R (I2S, SPDIF, ...)
+		std::uint32_t tolerance_ppm = 0;			   //!< Allowed deviation of every output in ppm
+	};
+
+	/**
+	 * @brief Divider and multiplier ranges of a PLL (RM0390, 6.3).
+	 */
+	struct pll_limits
+	{
+		std::uint32_t M_min, M_max;						//!< Input divider
+		std::uint32_t N_min, N_max;						//!< VCO multiplier
+		std::uint32_t Q_min, Q_max;						//!< Output divider Q
+		std::uint32_t R_min, R_max;						//!< Output divider R, 0 if not implemented
+		utils::quantity::Hz_t vco_in_min, vco_in_max;	//!< VCO input frequency
+		utils::quantity::Hz_t vco_out_min, vco_out_max; //!< VCO output frequency
+		utils::quantity::Hz_t P_max;					//!< Output P frequency
+	};
+
+	/**
+	 * @brief Limits of the main PLL and PLLI2S.
+	 */
+	inline constexpr pll_limits pll_main_limits{
+		2, 63, 50, 432, 2, 15, 2, 7, 1 * utils::unit::MHz, 2 * utils::unit::MHz, 100 * utils::unit::MHz, 432 * utils::unit::MHz,
+		180 * utils::unit::MHz};
+
+	/**
+	 * @brief Limits of PLLSAI, which has no R output.
+	 */
+	inline constexpr pll_limits pll_sai_limits{
+		2, 63, 50, 432, 2, 15, 0, 0, 1 * utils::unit::MHz, 2 * utils::unit::MHz, 100 * utils::unit::MHz, 432 * utils::unit::MHz,
+		180 * utils::unit::MHz};
+
+	/**
+	 * @brief Solved PLL configuration.
+	 *
+	 * Dividers of unused outputs are zero.
+	 */
+	struct pll_config
+	{
+		std::uint32_t M; //!< Input divider
+		std::uint32_t N; //!< VCO multiplier
+		std::uint32_t P; //!< Output divider P: 2, 4, 6, 8
+		std::uint32_t Q; //!< Output divider Q
+		std::uint32_t R; //!< Output divider R
+
+		/**
+		 * @brief Check whether the solver found a configuration.
+		 */
+		constexpr bool valid() const noexcept
+		{
+			return M != 0;
+		}
+
+		/**
+		 * @brief Frequency of an output for a given input frequency.
+		 *
+		 * @param source  PLL input frequency
+		 * @param divider Output divider P, Q or R of this configuration
+		 * @return Output frequency, rounded down; zero for unused outputs
+		 */
+		constexpr utils::quantity::Hz_t output(utils::quantity::Hz_t source, std::uint32_t divider) const noexcept
+		{
+			if (!valid() || divider == 0)
+				return 0 * utils::unit::Hz;
+			const std::uint64_t f = source.numerical_value_in(utils::unit::Hz);
+			return static_cast<std::uint32_t>(f * N / (static_cast<std::uint64_t>(M) * divider)) * utils::unit::Hz;
+		}
+	};
+
+	namespace detail
+	{
+		/**
+		 * @brief Deviation of source * N / (M * div) from target in ppm.
+		 */
+		constexpr std::uint64_t pll_error_ppm(std::uint64_t source, std::uint32_t M, std::uint32_t N,
+											  std::uint32_t div, std::uint64_t target) noexcept
+		{
+			const std::uint64_t actual = source * N;
+			const std::uint64_t wanted = target * M * div;
+			const std::uint64_t diff = actual > wanted ? actual - wanted : wanted - actual;
+			return diff * 1'000'000u / wanted;
+		}
+
+		/**
+		 * @brief Nearest divider for an output, clamped to its range.
+		 */
+		constexpr std::uint32_t pll_divider(std::uint64_t vco, std::uint64_t target, std::uint32_t min,
+											std::uint32_t max) noexcept
+		{
+			std::uint64_t div = (vco + target / 2) / target;
+			if (div < min)
+				div = min;
+			if (div > max)
+				div = max;
+			return static_cast<std::uint32_t>(div);
+		}
+	} // namespace detail
+
+	/**
+	 * @brief Find the best PLL configuration for a set of output frequencies.
+	 *
+	 * Instead of a brute force search over M, N and the dividers, only the
+	 * VCO input dividers M within the allowed VCO input range are visited.
+	 * For every M and every divider of the first requested output, N
+	 * follows from the target by division, so only the nearest multipliers
+	 * are tried. The remaining outputs take their nearest divider. That is
+	 * at most 62 * 4 * 3 candidates.
+	 *
+	 * A candidate is accepted if every requested output lies within
+	 * @p out.tolerance_ppm and the P output does not exceed
+	 * @p limits.P_max, even if the tolerance would allow it. Among those the one with the smallest total
+	 * deviation wins; on a tie the highest VCO input frequency (lowest
+	 * jitter) is kept. The search stops at the first exact match.
+	 *
+	 * @param source PLL input frequency
+	 * @param out    Requested outputs and tolerance
+	 * @param limits Divider ranges of the PLL
+	 * @return Best configuration, or all zero if no configuration is within tolerance
+	 */
+	constexpr pll_config pll_solve(utils::quantity::Hz_t source, pll_outputs out,
+								   const pll_limits &limits = pll_main_limits) noexcept
+	{
+		const std::uint64_t src = source.numerical_value_in(utils::unit::Hz);
+		const std::uint64_t p = out.P.numerical_value_in(utils::unit::Hz);
+		const std::uint64_t q = out.Q.numerical_value_in(utils::unit::Hz);
+		const std::uint64_t r = (limits.R_max != 0) ? out.R.numerical_value_in(utils::unit::Hz) : 0;
+		const std::uint64_t vco_in_min = limits.vco_in_min.numerical_value_in(utils::unit::Hz);
+		const std::uint64_t vco_in_max = limits.vco_in_max.numerical_value_in(utils::unit::Hz);
+		const std::uint64_t vco_out_min = limits.vco_out_min.numerical_value_in(utils::unit::Hz);
+		const std::uint64_t vco_out_max = limits.vco_out_max.numerical_value_in(utils::unit::Hz);
+		const std::uint64_t p_max = limits.P_max.numerical_value_in(utils::unit::Hz);
+
+		if (src == 0 || (p == 0 && q == 0 && r == 0) || (out.R.numerical_value_in(utils::unit::Hz) != 0 && r == 0))
+			return {};
+
+		// The first requested output determines N, its divider range is searched
+		const std::uint64_t primary = p ? p : (q ? q : r);
+		const std::uint32_t div_min = p ? 2 : (q ? limits.Q_min : limits.R_min);
+		const std::uint32_t div_max = p ? 8 : (q ? limits.Q_max : limits.R_max);
+		const std::uint32_t div_step = p ? 2 : 1;
+
+		std::uint32_t M_min = static_cast<std::uint32_t>((src + vco_in_max - 1) / vco_in_max);
+		std::uint32_t M_max = static_cast<std::uint32_t>(src / vco_in_min);
+		M_min = M_min < limits.M_min ? limits.M_min : M_min;
+		M_max = M_max > limits.M_max ? limits.M_max : M_max;
+
+		pll_config best{};
+		std::uint64_t best_error = ~std::uint64_t{0};
+
+		for (std::uint32_t M = M_min; M <= M_max; ++M)
+		{
+			for (std::uint32_t div = div_min; div <= div_max; div += div_step)
+			{
+				const std::uint64_t N_nearest = (primary * div * M + src / 2) / src;
+
+				for (std::uint64_t N = (N_nearest > 0 ? N_nearest - 1 : 0); N <= N_nearest + 1; ++N)
+				{
+					if (N < limits.N_min || N > limits.N_max)
+						continue;
+
+					const std::uint64_t vco = src * N / M;
+					if (vco < vco_out_min || vco > vco_out_max)
+						continue;
+
+					pll_config cfg{M, static_cast<std::uint32_t>(N), 0, 0, 0};
+					std::uint64_t total = 0;
+					bool accepted = true;
+
+					const auto check = [&](std::uint64_t target, std::uint32_t &divider, std::uint32_t d) {
+						divider = d;
+						const std::uint64_t e = detail::pll_error_ppm(src, cfg.M, cfg.N, d, target);
+						accepted = accepted && e <= out.tolerance_ppm;
+						total += e;
+					};
+
+					if (p && src * N > p_max * M * div)
+						continue;
+
+					if (p)
+						check(p, cfg.P, div);
+					if (q)
+						check(q, cfg.Q, p ? detail::pll_divider(vco, q, limits.Q_min, limits.Q_max) : div);
+					if (r)
+						check(r, cfg.R, (p || q) ? detail::pll_divider(vco, r, limits.R_min, limits.R_max) : div);
+
+					if (accepted && total < best_error)
+					{
+						best = cfg;
+						best_error = total;
+						if (total == 0)
+							return best;
+					}
+				}
+			}
+		}
+		return best;
+	}
+
+} // namespace stm32::f4
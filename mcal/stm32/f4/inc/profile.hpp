@@ -0,0 +1,262 @@
+/**
+ * @file profile.hpp
+ * @brief Cycle accurate profiling zones based on the DWT cycle counter.
+ *
+ * A zone measures the cycles between entering and leaving a scope:
+ * @code
+ * void control_loop() noexcept
+ * {
+ *     MCAL_PROFILE_ZONE("control loop");
+ *     ...
+ * }
+ * ...
+ * stm32::f4::profiler::dump(); // send all tables over ITM
+ * @endcode
+ *
+ * Zones are only compiled in if MCAL_PROFILE is defined (CMake option
+ * MCAL_PROFILE), otherwise MCAL_PROFILE_ZONE() expands to nothing.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "itm.hpp"
+#include "utils.hpp"
+
+namespace stm32::f4
+{
+	/**
+	 * @brief Statistics of one profiling zone in static storage.
+	 *
+	 * Histogram bin i counts the measurements of 2^i to 2^(i+1)-1 cycles
+	 * (bin 0 also counts 0 cycles).
+	 *
+	 * @note A zone must only be entered from one priority level, use
+	 *       separate zones for thread and interrupt code.
+	 */
+	struct profile_zone
+	{
+		static constexpr std::size_t bins = 32;									 //!< Number of log2 histogram bins
+		static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max(); //!< min without measurement
+
+		/**
+		 * @brief Create a zone, it is listed by profiler after its first measurement.
+		 *
+		 * @param zone_name Name printed by profiler::dump()
+		 */
+		constexpr explicit profile_zone(const char *zone_name) noexcept : name{zone_name}
+		{
+		}
+
+		/**
+		 * @brief Add one measurement.
+		 *
+		 * @param cycles Measured cycles
+		 */
+		void record(std::uint32_t cycles) noexcept
+		{
+			if (!linked.exchange(true, std::memory_order_relaxed))
+			{
+				link();
+			}
+
+			++count;
+			total += cycles;
+			min = cycles < min ? cycles : min;
+			max = cycles > max ? cycles : max;
+			++histogram[static_cast<std::size_t>(std::bit_width(cycles | 1u)) - 1];
+		}
+
+		/**
+		 * @brief Mean cycles per measurement.
+		 */
+		[[nodiscard]]
+		std::uint32_t mean() const noexcept
+		{
+			return count != 0 ? static_cast<std::uint32_t>(total / count) : 0;
+		}
+
+		/**
+		 * @brief Clear the statistics.
+		 */
+		void reset() noexcept
+		{
+			count = 0;
+			total = 0;
+			min = none;
+			max = 0;
+			histogram = {};
+		}
+
+		const char *name;							 //!< Zone name
+		std::uint32_t count = 0;					 //!< Number of measurements
+		std::uint32_t min = none;					 //!< Fewest cycles
+		std::uint32_t max = 0;						 //!< Most cycles
+		std::uint64_t total = 0;					 //!< Sum of all cycles
+		std::array<std::uint32_t, bins> histogram{}; //!< log2 cycle histogram
+		profile_zone *next = nullptr;				 //!< Next listed zone
+
+	  private:
+		/**
+		 * @brief Add the zone to the profiler list, safe against preemption.
+		 */
+		void link() noexcept;
+
+		std::atomic<bool> linked{false}; //!< Zone is listed
+
+		friend struct profiler;
+	};
+
+	/**
+	 * @brief Registry of all measured zones.
+	 */
+	struct profiler
+	{
+		/**
+		 * @brief Enable the cycle counter and calibrate the measurement overhead.
+		 *
+		 * The overhead is the fewest cycles measured by a few empty
+		 * profile_scope on a zone that is never listed, so it includes the
+		 * code of the scope around the two counter reads.
+		 */
+		static void enable() noexcept;
+
+		/**
+		 * @brief First listed zone, follow profile_zone::next for the rest.
+		 */
+		[[nodiscard]]
+		static profile_zone *zones() noexcept
+		{
+			return head.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief Clear the statistics of all zones.
+		 */
+		static void reset() noexcept
+		{
+			for (profile_zone *zone = zones(); zone != nullptr; zone = zone->next)
+			{
+				zone->reset();
+			}
+		}
+
+		/**
+		 * @brief Print the statistics and histograms of all zones.
+		 *
+		 * Output example:
+		 * @code
+		 * zone control loop: n=1000 min=412 mean=431 max=1873 cycles
+		 *       256..      511:       998
+		 *      1024..     2047:         2
+		 * @endcode
+		 *
+		 * Zones without a measurement since reset() are skipped.
+		 *
+		 * @tparam Sink Output, the default ITM port by default
+		 */
+		template <typename Sink = itm>
+		static void dump() noexcept
+		{
+			for (const profile_zone *zone = zones(); zone != nullptr; zone = zone->next)
+			{
+				if (zone->count == 0)
+				{
+					continue;
+				}
+				mcal::format::print<Sink, "zone {}: n={} min={} mean={} max={} cycles\n">(
+					zone->name, zone->count, zone->min, zone->mean(), zone->max);
+				for (std::size_t bin = 0; bin < profile_zone::bins; ++bin)
+				{
+					if (zone->histogram[bin] != 0)
+					{
+						const std::uint32_t low = bin == 0 ? 0u : (1u << bin);
+						const std::uint32_t high = (1u << bin) - 1u + (1u << bin);
+						mcal::format::print<Sink, "  {:>10}..{:>10}: {:>10}\n">(low, high,
+																			 zone->histogram[bin]);
+					}
+				}
+			}
+		}
+
+		static inline std::atomic<profile_zone *> head{nullptr}; //!< Listed zones
+		static inline std::uint32_t overhead = 0;				 //!< Cycles of an empty measurement
+
+	  private:
+		static constexpr std::uint32_t calibration_runs = 8; //!< Empty measurements of enable()
+	};
+
+	inline void profile_zone::link() noexcept
+	{
+		next = profiler::head.load(std::memory_order_relaxed);
+		while (!profiler::head.compare_exchange_weak(next, this, std::memory_order_release,
+													 std::memory_order_relaxed))
+		{
+		}
+	}
+
+	/**
+	 * @brief Measure the cycles of a scope into a zone.
+	 */
+	class profile_scope
+	{
+	  public:
+		explicit profile_scope(profile_zone &zone) noexcept : zone{zone}, start{cycle_counter::now()}
+		{
+		}
+
+		~profile_scope() noexcept
+		{
+			const std::uint32_t cycles = cycle_counter::now() - start;
+			zone.record(cycles > profiler::overhead ? cycles - profiler::overhead : 0);
+		}
+
+		profile_scope(const profile_scope &) = delete;
+		profile_scope &operator=(const profile_scope &) = delete;
+
+	  private:
+		profile_zone &zone;	 //!< Zone receiving the measurement
+		std::uint32_t start; //!< Cycle count at scope entry
+	};
+
+	inline void profiler::enable() noexcept
+	{
+		cycle_counter::enable();
+
+		static constinit profile_zone calibration{"calibration"};
+		calibration.linked.store(true, std::memory_order_relaxed);
+		calibration.reset();
+		overhead = 0;
+		for (std::uint32_t i = 0; i < calibration_runs; ++i)
+		{
+			const profile_scope scope{calibration};
+		}
+		overhead = calibration.min;
+	}
+
+} // namespace stm32::f4
+
+#define MCAL_PROFILE_CONCAT_(a, b) a##b
+#define MCAL_PROFILE_CONCAT(a, b) MCAL_PROFILE_CONCAT_(a, b)
+
+#ifdef MCAL_PROFILE
+/**
+ * @brief Measure the rest of the enclosing scope.
+ *
+ * @param name Zone name, a string literal
+ */
+#define MCAL_PROFILE_ZONE(name)                                                                                        \
+	static constinit ::stm32::f4::profile_zone MCAL_PROFILE_CONCAT(mcal_profile_zone_, __LINE__){name};              \
+	const ::stm32::f4::profile_scope MCAL_PROFILE_CONCAT(mcal_profile_scope_, __LINE__)                               \
+	{                                                                                                                  \
+		MCAL_PROFILE_CONCAT(mcal_profile_zone_, __LINE__)                                                              \
+	}
+#else
+#define MCAL_PROFILE_ZONE(name)
+#endif
@@ -0,0 +1,170 @@
+/**
+ * @file sections.hpp
+ * @brief Placement of code and data in the memory regions of STM32F446ZETX_FLASH.ld.
+ *
+ * Startup (see startup.cpp) initialises all regions through the copy and
+ * zero tables of the linker script, right after SystemEarlyInit(), except
+ * .noinit and .bss_lazy.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Execute a function from SRAM instead of flash.
+ *
+ * Instruction fetches from SRAM have no wait states, independent of the
+ * ART accelerator hitting or missing. The code is copied from flash at
+ * startup, so a RAM function must not be called from SystemEarlyInit().
+ * Calls into SRAM are out of BL range and use long_call; calls from a
+ * RAM function back into flash go through linker veneers, so keep hot
+ * paths self-contained.
+ *
+ * Example:
+ * @code
+ * MCAL_RAMFUNC void fir(const float *in, float *out, std::size_t n) noexcept;
+ * @endcode
+ *
+ * Use on the declaration seen by the callers, and only for non-inline
+ * functions: inline and template functions are emitted per translation
+ * unit and merged by the linker, which does not reliably keep the section.
+ */
+#ifdef MCAL_HOST
+#define MCAL_RAMFUNC [[gnu::section(".ramfunc"), gnu::noinline]]
+#else
+#define MCAL_RAMFUNC [[gnu::section(".ramfunc"), gnu::noinline, gnu::long_call]]
+#endif
+
+/**
+ * @brief Place a DMA buffer in SRAM1, zeroed at startup.
+ *
+ * SRAM1 and SRAM2 are separate bus matrix slaves. DMA buffers stay in
+ * SRAM1, the stack and hot data in SRAM2, so DMA streams and the CPU
+ * do not wait for each other on the same bank.
+ *
+ * Example:
+ * @code
+ * MCAL_DMA_BUFFER static std::array<std::uint16_t, 512> adc_samples;
+ * @endcode
+ */
+#define MCAL_DMA_BUFFER [[gnu::section(".dma_buffer"), gnu::aligned(4)]]
+
+/**
+ * @brief Place frequently accessed data in SRAM2, initialised at startup like .data.
+ */
+#define MCAL_FAST_DATA [[gnu::section(".fast_data")]]
+
+/**
+ * @brief Place a stack (e.g. of an RTOS task) in SRAM2 next to the MSP stack, not initialised.
+ */
+#define MCAL_STACK_SRAM2 [[gnu::section(".stack_sram2"), gnu::aligned(8)]]
+
+/**
+ * @brief Place data in SRAM1 that the startup never initialises.
+ *
+ * The contents survive a watchdog or software reset (not a power cycle),
+ * so validate them, e.g. with a magic number or checksum, before use.
+ * Also suited for large buffers that are always written before read.
+ */
+#define MCAL_NOINIT [[gnu::section(".noinit")]]
+
+/**
+ * @brief Place zero initialised data in SRAM1 that is cleared by lazy_bss instead of the startup.
+ */
+#define MCAL_BSS_LAZY [[gnu::section(".bss_lazy"), gnu::aligned(4)]]
+
+#ifndef MCAL_HOST
+extern "C" std::uint32_t __bss_lazy_start__[]; // start of .bss_lazy
+extern "C" std::uint32_t __bss_lazy_end__[];   // end of .bss_lazy
+#endif
+
+namespace stm32::f4
+{
+	/**
+	 * @brief Deferred zeroing of the .bss_lazy section.
+	 *
+	 * Moves the clearing of large MCAL_BSS_LAZY buffers out of the reset
+	 * path. Either clear everything before first use with zero(), or let
+	 * a background context (RTOS idle hook, lowest priority task) call
+	 * zero_step() until it returns true:
+	 * @code
+	 * MCAL_BSS_LAZY static std::array<float, 4096> history;
+	 * ...
+	 * extern "C" void vApplicationIdleHook(void)
+	 * {
+	 *     (void)stm32::f4::lazy_bss::zero_step();
+	 * }
+	 * @endcode
+	 *
+	 * @note Call from one context only, zero() and zero_step() share the progress.
+	 */
+	struct lazy_bss
+	{
+		/**
+		 * @brief Clear the rest of the section, returns at once if already done.
+		 */
+		static void zero() noexcept
+		{
+			const std::size_t total = words();
+			for (; done < total; ++done)
+			{
+				begin()[done] = 0;
+			}
+		}
+
+		/**
+		 * @brief Clear the next chunk of the section.
+		 *
+		 * @tparam chunk_words Words cleared per call
+		 * @return True once the whole section is zero
+		 */
+		template <std::uint32_t chunk_words = 256>
+		static bool zero_step() noexcept
+		{
+			static_assert(chunk_words > 0, "Chunk must not be empty");
+
+			// Clamp before adding, done + chunk_words may wrap with a 32 bit size_t
+			const std::size_t total = words();
+			const std::size_t end = done + std::min<std::size_t>(chunk_words, total - done);
+			for (; done < end; ++done)
+			{
+				begin()[done] = 0;
+			}
+			return done == total;
+		}
+
+		/**
+		 * @brief Check whether the whole section is zero.
+		 */
+		[[nodiscard]]
+		static bool is_zeroed() noexcept
+		{
+			return done == words();
+		}
+
+	  private:
+		static std::uint32_t *begin() noexcept
+		{
+#ifdef MCAL_HOST
+			return nullptr;
+#else
+			return __bss_lazy_start__;
+#endif
+		}
+
+		static std::size_t words() noexcept
+		{
+#ifdef MCAL_HOST
+			return 0;
+#else
+			return static_cast<std::size_t>(__bss_lazy_end__ - __bss_lazy_start__);
+#endif
+		}
+
+		static inline std::size_t done = 0; //!< Words cleared so far
+	};
+
+} // namespace stm32::f4
@@ -0,0 +1,128 @@
+/**
+ * @file timebase.hpp
+ * @brief 64-bit monotonic clock on a free-running 32-bit timer.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "mcal.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+
+#include "device.hpp"
+
+#include "units.hpp"
+
+namespace stm32::f4
+{
+	/**
+	 * @brief Monotonic µs clock, meets mcal::concepts::Clock.
+	 *
+	 * The timer counts µs over its full 32 bit range. now() extends the
+	 * count to 64 bit in software, detecting a wrap-around by comparing
+	 * it with the previous reading. No interrupt is used. now() must
+	 * therefore run at least once per wrap period of 2^32 µs (71 minutes),
+	 * which any polling loop does anyway.
+	 *
+	 * If the timer kernel clock changes at runtime (clock_profiles), pass
+	 * the new clock to set_timer_clock() from the profile listener, or
+	 * now() runs fast or slow by the ratio of the clocks. The time passed
+	 * during the switch itself is only approximate.
+	 *
+	 * @tparam Timer              32-bit timer, e.g. Timer2
+	 * @tparam TIMER_FREQUENCY_HZ Timer kernel clock at startup (see clock_tree::timer_clock1())
+	 */
+	template <typename Timer, utils::quantity::Hz_t TIMER_FREQUENCY_HZ>
+	struct MonotonicClockImpl
+	{
+		static_assert(TIMER_FREQUENCY_HZ.numerical_value_in(utils::unit::Hz) % 1'000'000 == 0,
+					  "Timer clock must be a multiple of 1 MHz for µs resolution.");
+
+		/**
+		 * @brief Prescaler giving 1 µs timer ticks.
+		 */
+		static constexpr std::uint32_t prescaler =
+			TIMER_FREQUENCY_HZ.numerical_value_in(utils::unit::Hz) / 1'000'000 - 1;
+
+		static_assert(prescaler <= 0xFFFF, "Timer clock too high for the 16 bit prescaler.");
+
+		/**
+		 * @brief Start the timer from zero.
+		 */
+		static void init() noexcept
+		{
+			TIM_TypeDef *const tim = Timer::tim();
+			Timer::enable();
+			Register::store(tim->CR1, 0u);
+			Register::store(tim->PSC, active_prescaler);
+			Register::store(tim->ARR, 0xFFFF'FFFFu);
+			Register::store(tim->CNT, 0u);
+			Register::store(tim->EGR, TIM_EGR_UG);
+			Register::store(tim->SR, 0u);
+			low = 0;
+			high = 0;
+			Register::set(tim->CR1, TIM_CR1_CEN);
+		}
+
+		/**
+		 * @brief Follow a change of the timer kernel clock.
+		 *
+		 * The prescaler is only loaded on an update event, which the free
+		 * running timer has once per wrap. The update is therefore forced
+		 * and the count written back, so now() continues without a jump.
+		 *
+		 * @param timer_clock New timer kernel clock, see is_us_timer_clock()
+		 */
+		static void set_timer_clock(utils::quantity::Hz_t timer_clock) noexcept
+		{
+			active_prescaler = us_timer_prescaler(timer_clock);
+			if (!is_running())
+			{
+				return;
+			}
+
+			const interrupt_lock lock;
+			TIM_TypeDef *const tim = Timer::tim();
+			const std::uint32_t count = Register::read(tim->CNT);
+			Register::store(tim->PSC, active_prescaler);
+			Register::store(tim->EGR, TIM_EGR_UG);
+			Register::store(tim->CNT, count);
+			Register::store(tim->SR, 0u);
+		}
+
+		/**
+		 * @brief Check whether init() started the timer.
+		 */
+		[[nodiscard]]
+		static bool is_running() noexcept
+		{
+			return Timer::is_enabled() && Register::read(Timer::tim()->CR1, TIM_CR1_CEN) != 0;
+		}
+
+		/**
+		 * @brief Time since init().
+		 *
+		 * Safe to call from any context.
+		 */
+		[[nodiscard]]
+		static utils::quantity::us64_t now() noexcept
+		{
+			const interrupt_lock lock;
+			const std::uint32_t count = Register::read(Timer::tim()->CNT);
+			if (count < low)
+			{
+				++high;
+			}
+			low = count;
+			return ((std::uint64_t{high} << 32) | count) * utils::unit::us;
+		}
+
+	  private:
+		static inline std::uint32_t active_prescaler = prescaler; //!< Prescaler for the current timer clock
+		static inline std::uint32_t low = 0;					  //!< Last timer reading
+		static inline std::uint32_t high = 0;					  //!< Wrap-arounds seen
+	};
+
+} // namespace stm32::f4
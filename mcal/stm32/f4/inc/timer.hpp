@@ -0,0 +1,81 @@
+/**
+ * @file timer.hpp
+ * @brief 32-bit general-purpose timers TIM2 and TIM5.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "mcal.hpp"
+#include "nvic.hpp"
+
+#include "device.hpp"
+
+namespace stm32::f4
+{
+	/**
+	 * @brief General-purpose 32-bit timer on APB1.
+	 *
+	 * @tparam TIM_BASE            Base address of the timer.
+	 * @tparam RCC_APB1ENR_TIMxEN  Bit mask enabling the timer clock in RCC->APB1ENR.
+	 * @tparam TIMx_IRQn           Interrupt number of the timer.
+	 */
+	template <uint32_t TIM_BASE, uint32_t RCC_APB1ENR_TIMxEN, IRQn_Type TIMx_IRQn>
+	struct TimerImpl
+	{
+		static constexpr IRQn_Type irq = TIMx_IRQn; //!< Interrupt number
+
+		/**
+		 * @brief Get a typed pointer to the timer registers.
+		 */
+		static TIM_TypeDef *tim() noexcept
+		{
+			return mcal::peripheral<TIM_TypeDef>(TIM_BASE);
+		}
+
+		/**
+		 * @brief Enable the clock of the timer.
+		 */
+		static void enable() noexcept
+		{
+			Register::set(RCC->APB1ENR, RCC_APB1ENR_TIMxEN);
+		}
+
+		/**
+		 * @brief Disable the clock of the timer.
+		 */
+		static void disable() noexcept
+		{
+			Register::clear(RCC->APB1ENR, RCC_APB1ENR_TIMxEN);
+		}
+
+		/**
+		 * @brief Check whether the timer clock is enabled.
+		 */
+		[[nodiscard]]
+		static bool is_enabled() noexcept
+		{
+			return Register::read(RCC->APB1ENR, RCC_APB1ENR_TIMxEN) != 0;
+		}
+
+		/**
+		 * @brief Clear a pending timer interrupt in the NVIC.
+		 */
+		static void clear_pending() noexcept
+		{
+			nvic::clear_pending<TIMx_IRQn>();
+		}
+	};
+
+	/**
+	 * @brief TIM2, 32 bit, APB1.
+	 */
+	using Timer2 = TimerImpl<TIM2_BASE, RCC_APB1ENR_TIM2EN, TIM2_IRQn>;
+
+	/**
+	 * @brief TIM5, 32 bit, APB1.
+	 */
+	using Timer5 = TimerImpl<TIM5_BASE, RCC_APB1ENR_TIM5EN, TIM5_IRQn>;
+
+} // namespace stm32::f4
@@ -8,12 +8,16 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <utility>
 
 #include "clock.hpp"
 #include "mcal.hpp"
+#include "timer.hpp"
 
-#include "stm32f4xx.h"
+#include "device.hpp"
 
 #include "units.hpp"
 
@@ -25,9 +29,113 @@ namespace stm32
 namespace stm32::f4
 {
 
+	/**
+	 * @brief Masks interrupts (PRIMASK) for the lifetime of the object.
+	 *
+	 * Restores the previous state, so locks may nest. No-op in host builds.
+	 */
+	class interrupt_lock
+	{
+	  public:
+		interrupt_lock() noexcept
+		{
+#ifndef MCAL_HOST
+			saved = __get_PRIMASK();
+			__disable_irq();
+#endif
+		}
+
+		~interrupt_lock() noexcept
+		{
+#ifndef MCAL_HOST
+			__set_PRIMASK(saved);
+#endif
+		}
+
+		interrupt_lock(const interrupt_lock &) = delete;
+		interrupt_lock &operator=(const interrupt_lock &) = delete;
+
+	  private:
+		std::uint32_t saved = 0; //!< PRIMASK on entry
+	};
+
+	/**
+	 * @brief Cortex-M DWT cycle counter.
+	 */
+	struct cycle_counter
+	{
+		/**
+		 * @brief Enable the DWT cycle counter.
+		 */
+		static inline void enable() noexcept
+		{
+			Register::set(CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk);
+			Register::set(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk);
+		}
+
+		/**
+		 * @brief Current cycle count, wraps around after 2^32 cycles.
+		 */
+		[[nodiscard]]
+		static inline std::uint32_t now() noexcept
+		{
+			return Register::read(DWT->CYCCNT);
+		}
+
+		/**
+		 * @brief Busy-wait until @p cycles have passed since @p start.
+		 *
+		 * @param start  Cycle count the wait is measured from
+		 * @param cycles Cycles to wait, less than 2^32
+		 */
+		static inline void wait(std::uint32_t start, std::uint32_t cycles) noexcept
+		{
+			while ((now() - start) < cycles)
+			{
+				// busy wait
+			}
+		}
+
+		/**
+		 * @brief Busy-wait for a number of µs without overflowing the counter.
+		 *
+		 * Long delays are split into chunks below 2^31 cycles. Every chunk
+		 * continues from the end of the previous one, so the split adds no
+		 * drift.
+		 *
+		 * @param us            Delay time in µs, the full 32 bit range
+		 * @param cycles_per_us Core clock in MHz
+		 */
+		static inline void wait_us(std::uint32_t us, std::uint32_t cycles_per_us) noexcept
+		{
+			const std::uint32_t chunk_us = (1u << 31) / cycles_per_us;
+			std::uint32_t start = now();
+			while (us > chunk_us)
+			{
+				wait(start, chunk_us * cycles_per_us);
+				start += chunk_us * cycles_per_us;
+				us -= chunk_us;
+			}
+			wait(start, us * cycles_per_us);
+		}
+	};
+
 	/**
 	 * @brief Blocking delay using the Cortex-M DWT cycle counter.
 	 *
+	 * The runtime overload waits for a number of µs. The compile-time
+	 * overload converts a ns duration to core cycles at compile time and
+	 * waits cycle-exactly, for bit-banged protocols such as WS2812 or
+	 * 1-Wire:
+	 * @code
+	 * Delay::blocking<350 * utils::unit::ns>();
+	 * Delay::pulse<Pin, 400 * utils::unit::ns, 850 * utils::unit::ns>(); // WS2812 "0" bit
+	 * @endcode
+	 *
+	 * @note Cycle-exact timing assumes the code runs without flash wait
+	 *       states (ART accelerator hit or RAM) and without interrupts;
+	 *       interrupts can only lengthen a delay.
+	 *
 	 * @tparam CPU_FREQUENCY_HZ Core clock frequency.
 	 */
 	template <utils::quantity::Hz_t CPU_FREQUENCY_HZ>
@@ -36,36 +144,304 @@ namespace stm32::f4
 		static_assert(CPU_FREQUENCY_HZ >= (1 * utils::unit::MHz),
 					  "CPU_FREQUENCY_HZ must be >= 1 MHz for µs resolution.");
 
+		/**
+		 * @brief Core cycles per µs.
+		 */
+		static constexpr std::uint32_t cycles_per_us = CPU_FREQUENCY_HZ.numerical_value_in(utils::unit::Hz) / 1'000'000;
+
+		/**
+		 * @brief Cycles of one iteration of the delay loop (SUBS and a taken BNE).
+		 */
+		static constexpr std::uint32_t loop_cycles = 3;
+
+		/**
+		 * @brief Cycles of a GPIO write (store to BSRR), see pulse().
+		 */
+		static constexpr std::uint32_t gpio_write_cycles = 2;
+
+		/**
+		 * @brief Core cycles of a duration, rounded up.
+		 */
+		static constexpr std::uint32_t cycles(utils::quantity::ns_t duration) noexcept
+		{
+			const std::uint64_t product = std::uint64_t{duration.numerical_value_in(utils::unit::ns)} *
+										  CPU_FREQUENCY_HZ.numerical_value_in(utils::unit::Hz);
+			return static_cast<std::uint32_t>((product + 999'999'999u) / 1'000'000'000u);
+		}
+
 		/**
 		 * @brief Enable the DWT cycle counter.
 		 */
 		static inline void enable_dwt() noexcept
 		{
-			Register::set(CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk);
-			Register::set(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk);
+			cycle_counter::enable();
 		}
 
 		/**
 		 * @brief Busy-wait for a given duration.
 		 *
+		 * Supports the full 32 bit µs range (see cycle_counter::wait_us()).
+		 *
 		 * @param duration Delay time in µs.
 		 */
 		static inline void blocking(utils::quantity::us_t duration) noexcept
 		{
 			enable_dwt();
+			cycle_counter::wait_us(duration.numerical_value_in(utils::unit::us), cycles_per_us);
+		}
 
-			const uint32_t ticks = duration.numerical_value_in(utils::unit::us) *
-								   (CPU_FREQUENCY_HZ.numerical_value_in(utils::unit::Hz) / 1'000'000);
+		/**
+		 * @brief Busy-wait for a duration known at compile time.
+		 *
+		 * @tparam duration Delay time
+		 * @tparam overhead Cycles spent by the caller that count towards the delay
+		 */
+		template <utils::quantity::ns_t duration, std::uint32_t overhead = 0>
+		[[gnu::always_inline]]
+		static inline void blocking() noexcept
+		{
+			constexpr std::uint32_t total = cycles(duration);
+			spin<(total > overhead) ? total - overhead : 0>();
+		}
 
-			const std::uint32_t start = Register::read(DWT->CYCCNT);
+		/**
+		 * @brief Drive one high/low pulse with exact phase lengths.
+		 *
+		 * The GPIO writes are part of the phase they start.
+		 *
+		 * @tparam Pin  Output pin (GpioPin)
+		 * @tparam high Time the pin is high
+		 * @tparam low  Time the pin is low
+		 */
+		template <typename Pin, utils::quantity::ns_t high, utils::quantity::ns_t low>
+		[[gnu::always_inline]]
+		static inline void pulse() noexcept
+		{
+			Pin::set();
+			blocking<high, gpio_write_cycles>();
+			Pin::clear();
+			blocking<low, gpio_write_cycles>();
+		}
 
-			while ((Register::read(DWT->CYCCNT) - start) < ticks)
+		/**
+		 * @brief Busy-wait for a number of cycles known at compile time.
+		 *
+		 * Short waits run a SUBS/BNE loop padded with NOPs; the loop counter
+		 * setup and the final, not taken BNE together cost one loop
+		 * iteration. Waits beyond the range of a 16 bit loop counter poll the
+		 * cycle counter instead.
+		 *
+		 * @tparam count Cycles to wait
+		 */
+		template <std::uint32_t count>
+		[[gnu::always_inline]]
+		static inline void spin() noexcept
+		{
+			constexpr std::uint32_t loops = count / loop_cycles;
+			if constexpr (loops > 0xFFFF)
 			{
-				// busy wait
+				enable_dwt();
+				cycle_counter::wait(cycle_counter::now(), count);
 			}
+			else
+			{
+#ifndef MCAL_HOST
+				if constexpr (loops > 0)
+				{
+					std::uint32_t remaining = loops;
+					asm volatile("1: subs %0, %0, #1\n\tbne 1b" : "+r"(remaining) : : "cc");
+				}
+				[]<std::size_t... I>(std::index_sequence<I...>) {
+					((static_cast<void>(I), __NOP()), ...);
+				}(std::make_index_sequence<count % loop_cycles>{});
+#endif
+			}
+		}
+	};
+
+	/**
+	 * @brief Blocking delay following the current core clock.
+	 *
+	 * Scales with SystemCoreClock at every call, so it stays correct across
+	 * runtime clock profile switches (see clock_profiles) at the cost of
+	 * one division per call.
+	 */
+	struct SystemClockDelay
+	{
+		/**
+		 * @brief Busy-wait for a given duration.
+		 *
+		 * @param duration Delay time in µs.
+		 */
+		static inline void blocking(utils::quantity::us_t duration) noexcept
+		{
+			cycle_counter::enable();
+			cycle_counter::wait_us(duration.numerical_value_in(utils::unit::us), SystemCoreClock / 1'000'000);
 		}
 	};
 
+	/**
+	 * @brief Sleep until an event or a pending interrupt (WFE).
+	 *
+	 * Returns immediately in host builds.
+	 */
+	inline void wait_for_event() noexcept
+	{
+#ifndef MCAL_HOST
+		__WFE();
+#endif
+	}
+
+	/**
+	 * @brief Check whether a timer kernel clock gives exact 1 µs ticks with the 16 bit prescaler.
+	 *
+	 * @param timer_clock Timer kernel clock
+	 */
+	constexpr bool is_us_timer_clock(utils::quantity::Hz_t timer_clock) noexcept
+	{
+		const std::uint32_t f = timer_clock.numerical_value_in(utils::unit::Hz);
+		return f != 0 && f % 1'000'000 == 0 && f / 1'000'000 - 1 <= 0xFFFF;
+	}
+
+	/**
+	 * @brief Prescaler giving 1 µs ticks from a timer kernel clock.
+	 *
+	 * @param timer_clock Timer kernel clock, see is_us_timer_clock()
+	 */
+	constexpr std::uint32_t us_timer_prescaler(utils::quantity::Hz_t timer_clock) noexcept
+	{
+		return timer_clock.numerical_value_in(utils::unit::Hz) / 1'000'000 - 1;
+	}
+
+	/**
+	 * @brief Delay sleeping in WFE until a one-pulse timer expires.
+	 *
+	 * The timer counts µs in one-pulse mode, and its update interrupt is
+	 * enabled in the timer but not in the NVIC. With SCB->SCR SEVONPEND, the
+	 * interrupt becoming pending wakes the core from WFE. No handler is
+	 * needed and other interrupts are still served during the delay. The
+	 * core sleeps between wake-ups instead of polling the cycle counter.
+	 * SCB->SCR is restored on return.
+	 *
+	 * Delays of up to 2^32 µs are supported, from 1 µs (2 µs with a 1 MHz
+ * timer kernel clock).
+	 * Not reentrant: use one timer per context that delays.
+	 *
+	 * If the timer kernel clock changes at runtime (clock_profiles), pass
+	 * the new clock to set_timer_clock() from the profile listener.
+	 *
+	 * @tparam Timer              32-bit timer, e.g. Timer5
+	 * @tparam TIMER_FREQUENCY_HZ Timer kernel clock at startup (see clock_tree::timer_clock1())
+	 */
+	template <typename Timer, utils::quantity::Hz_t TIMER_FREQUENCY_HZ>
+	struct SleepDelayImpl
+	{
+		static_assert(TIMER_FREQUENCY_HZ.numerical_value_in(utils::unit::Hz) % 1'000'000 == 0,
+					  "Timer clock must be a multiple of 1 MHz for µs resolution.");
+
+		/**
+		 * @brief Prescaler giving 1 µs timer ticks.
+		 */
+		static constexpr std::uint32_t prescaler =
+			TIMER_FREQUENCY_HZ.numerical_value_in(utils::unit::Hz) / 1'000'000 - 1;
+
+		static_assert(prescaler <= 0xFFFF, "Timer clock too high for the 16 bit prescaler.");
+
+		/**
+		 * @brief Follow a change of the timer kernel clock.
+		 *
+		 * Takes effect with the next delay.
+		 *
+		 * @param timer_clock New timer kernel clock, see is_us_timer_clock()
+		 */
+		static void set_timer_clock(utils::quantity::Hz_t timer_clock) noexcept
+		{
+			active_prescaler = us_timer_prescaler(timer_clock);
+		}
+
+		/**
+		 * @brief Background work run while the delay waits.
+		 *
+		 * Returns true while work is left; the core only sleeps once it
+		 * returned false. Keep each call short, the delay ends late by at
+		 * most one call.
+		 */
+		using idle_hook = bool (*)() noexcept;
+
+		/**
+		 * @brief Sleep for a given duration.
+		 *
+		 * A 1 µs delay needs a timer kernel clock of at least 2 MHz, at 1 MHz
+		 * it lasts 2 µs.
+		 *
+		 * @param duration Delay time in µs.
+		 * @param idle     Background work run before every sleep, e.g. draining the ITM output
+		 */
+		static void blocking(utils::quantity::us_t duration, idle_hook idle = nullptr) noexcept
+		{
+			const std::uint32_t ticks = duration.numerical_value_in(utils::unit::us);
+			if (ticks == 0)
+			{
+				return;
+			}
+
+			TIM_TypeDef *const tim = Timer::tim();
+			Timer::enable();
+			const std::uint32_t scr = Register::load(SCB->SCR);
+			Register::store(SCB->SCR, scr | SCB_SCR_SEVONPEND_Msk);
+
+			// Load prescaler and period, URS keeps the UG event from flagging an update
+			Register::store(tim->CR1, TIM_CR1_URS | TIM_CR1_OPM);
+			if (ticks > 1)
+			{
+				Register::store(tim->PSC, active_prescaler);
+				Register::store(tim->ARR, ticks - 1);
+			}
+			else
+			{
+				// ARR = 0 stops the counter, so count 1 µs in kernel clock cycles
+				Register::store(tim->PSC, 0u);
+				Register::store(tim->ARR, active_prescaler > 0 ? active_prescaler : 1u);
+			}
+			Register::store(tim->EGR, TIM_EGR_UG);
+			Register::store(tim->SR, 0u);
+			Register::store(tim->DIER, TIM_DIER_UIE);
+			Timer::clear_pending();
+
+			Register::set(tim->CR1, TIM_CR1_CEN);
+			while (Register::read(tim->SR, TIM_SR_UIF) == 0)
+			{
+				// Woken by the pending update interrupt or any other event
+				if (idle == nullptr || !idle())
+				{
+					wait_for_event();
+				}
+			}
+
+			Register::store(tim->DIER, 0u);
+			Register::store(tim->SR, 0u);
+			Timer::clear_pending();
+			Register::store(SCB->SCR, scr);
+		}
+
+	  private:
+		static inline std::uint32_t active_prescaler = prescaler; //!< Prescaler for the current timer clock
+	};
+
+	/**
+	 * @brief Reprogram the SysTick period for a new core clock.
+	 *
+	 * Keeps the tick rate of an RTOS constant after a clock switch.
+	 *
+	 * @param hclk      New core clock frequency
+	 * @param tick_rate Tick frequency in Hz
+	 */
+	inline void set_tick_rate(utils::quantity::Hz_t hclk, std::uint32_t tick_rate) noexcept
+	{
+		Register::store(SysTick->LOAD, hclk.numerical_value_in(utils::unit::Hz) / tick_rate - 1u);
+		Register::store(SysTick->VAL, 0u);
+	}
+
 	/**
 	 * @brief Initialize ITM/SWO output for debug printing.
 	 */
@@ -81,11 +457,15 @@ extern "C"
 	/**
 	 * @brief Low-level character output hook for printf().
 	 *
-	 * Redirects output to ITM stimulus port 0.
+	 * Redirects output to ITM stimulus port 0, or to stdout in host builds.
 	 */
 	int __io_putchar(int ch) noexcept
 	{
+#ifdef MCAL_HOST
+		std::putchar(ch);
+#else
 		ITM_SendChar(static_cast<std::uint32_t>(ch));
+#endif
 		return 0;
 	}
 }
@@ -0,0 +1,50 @@
+/**
+ * @file exti.cpp
+ * @brief EXTI interrupt handlers dispatching to the ExtiPin bindings.
+ *
+ * Override the weak aliases of startup.cpp. Handlers for EXTI lines are
+ * bound with ExtiPin::init() instead of defining EXTIx_IRQHandler.
+ * The handlers run from SRAM to keep the interrupt latency free of
+ * flash wait states.
+ */
+
+#include "exti.hpp"
+#include "sections.hpp"
+
+extern "C"
+{
+	MCAL_RAMFUNC void EXTI0_IRQHandler(void)
+	{
+		stm32::f4::exti::dispatch<0, 0>();
+	}
+
+	MCAL_RAMFUNC void EXTI1_IRQHandler(void)
+	{
+		stm32::f4::exti::dispatch<1, 1>();
+	}
+
+	MCAL_RAMFUNC void EXTI2_IRQHandler(void)
+	{
+		stm32::f4::exti::dispatch<2, 2>();
+	}
+
+	MCAL_RAMFUNC void EXTI3_IRQHandler(void)
+	{
+		stm32::f4::exti::dispatch<3, 3>();
+	}
+
+	MCAL_RAMFUNC void EXTI4_IRQHandler(void)
+	{
+		stm32::f4::exti::dispatch<4, 4>();
+	}
+
+	MCAL_RAMFUNC void EXTI9_5_IRQHandler(void)
+	{
+		stm32::f4::exti::dispatch<5, 9>();
+	}
+
+	MCAL_RAMFUNC void EXTI15_10_IRQHandler(void)
+	{
+		stm32::f4::exti::dispatch<10, 15>();
+	}
+}
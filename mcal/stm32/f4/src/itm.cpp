@@ -0,0 +1,34 @@
+/**
+ * @file itm.cpp
+ * @brief Buffered stdout/stderr over ITM/SWO.
+ *
+ * Overrides the weak _write() of syscalls.c: printf() only copies into the
+ * lock-free buffer of stm32::f4::itm and returns. The application drains
+ * the buffer in the background with stm32::f4::itm::drain() or flush().
+ */
+
+#include <cstdint>
+#include <span>
+
+#include "itm.hpp"
+
+extern "C"
+{
+	/**
+	 * @brief Queue output for the ITM stimulus port.
+	 *
+	 * Never blocks. Data which does not fit is dropped and counted in
+	 * stm32::f4::itm::dropped(), so the full length is always reported to
+	 * keep newlib from retrying.
+	 */
+	int _write(int file, char *ptr, int len)
+	{
+		(void)file;
+		if (len > 0)
+		{
+			stm32::f4::itm::write(
+				std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t *>(ptr), static_cast<std::size_t>(len)));
+		}
+		return len;
+	}
+}
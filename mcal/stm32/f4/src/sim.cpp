@@ -0,0 +1,175 @@
+/**
+ * @file sim.cpp
+ * @brief STM32F4 device model for host builds (MCAL_HOST).
+ *
+ * Replaces system_stm32f4xx.c and adds the register behaviour the drivers
+ * rely on, so the MCAL runs against the simulated register files:
+ * - RCC oscillator and PLL ready flags follow their enable bits,
+ * - the oscillator or PLL running as system clock can not be disabled,
+ * - RCC_CFGR.SWS follows RCC_CFGR.SW one read of RCC_CFGR later,
+ * - PWR over-drive ready flags follow their enable bits, over-drive can
+ *   only be left while the system clock is not the PLL,
+ * - DWT->CYCCNT advances on every read while the counter is enabled.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "device.hpp"
+
+#ifndef HSE_VALUE
+#define HSE_VALUE 25000000u //!< Default HSE frequency, as in system_stm32f4xx.c
+#endif
+#ifndef HSI_VALUE
+#define HSI_VALUE 16000000u //!< HSI frequency, as in system_stm32f4xx.c
+#endif
+
+extern "C"
+{
+	uint32_t SystemCoreClock = 16000000; //!< Core clock frequency in Hz
+
+	const uint8_t AHBPrescTable[16] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 6, 7, 8, 9}; //!< AHB prescaler shifts
+	const uint8_t APBPrescTable[8] = {0, 0, 0, 0, 1, 2, 3, 4};						   //!< APB prescaler shifts
+
+	/**
+	 * @brief Nothing to do for the simulated device.
+	 */
+	void SystemInit(void)
+	{
+	}
+
+	void SystemCoreClockUpdate(void);
+}
+
+namespace
+{
+	constexpr std::uint32_t rcc_cr = RCC_BASE + offsetof(RCC_TypeDef, CR);			  //!< RCC_CR address
+	constexpr std::uint32_t rcc_pllcfgr = RCC_BASE + offsetof(RCC_TypeDef, PLLCFGR); //!< RCC_PLLCFGR address
+	constexpr std::uint32_t rcc_cfgr = RCC_BASE + offsetof(RCC_TypeDef, CFGR);		  //!< RCC_CFGR address
+	constexpr std::uint32_t pwr_cr = PWR_BASE + offsetof(PWR_TypeDef, CR);			  //!< PWR_CR address
+	constexpr std::uint32_t pwr_csr = PWR_BASE + offsetof(PWR_TypeDef, CSR);		  //!< PWR_CSR address
+	constexpr std::uint32_t dwt_ctrl = DWT_BASE + offsetof(DWT_Type, CTRL);			  //!< DWT_CTRL address
+	constexpr std::uint32_t dwt_cyccnt = DWT_BASE + offsetof(DWT_Type, CYCCNT);		  //!< DWT_CYCCNT address
+
+	/**
+	 * @brief Core cycles that pass between two reads of DWT->CYCCNT.
+	 *
+	 * Large enough to keep simulated busy-wait loops short.
+	 */
+	constexpr std::uint32_t cycles_per_read = 1000;
+
+	/**
+	 * @brief Reads of RCC_CFGR that still report the previous system clock after a switch.
+	 */
+	constexpr std::uint32_t switch_reads = 1;
+
+	std::uint32_t pending_switch_reads = 0; //!< Reads left until SWS follows SW
+
+	/**
+	 * @brief System clock source reported by RCC_CFGR.SWS, as RCC_CFGR_SWS_x value.
+	 */
+	std::uint32_t sysclk_status() noexcept
+	{
+		return mcal::sim::at(rcc_cfgr) & RCC_CFGR_SWS_Msk;
+	}
+
+	/**
+	 * @brief Install reset values and hooks of the STM32F4 model.
+	 */
+	void install()
+	{
+		using mcal::sim::at;
+		using mcal::sim::bus;
+
+		at(rcc_cr) = RCC_CR_HSION | RCC_CR_HSIRDY | (0x10u << RCC_CR_HSITRIM_Pos);
+		at(rcc_pllcfgr) = 0x2400'3010u;
+		at(pwr_cr) = PWR_CR_VOS_Msk;
+		at(pwr_csr) = PWR_CSR_VOSRDY;
+
+		pending_switch_reads = 0;
+
+		bus::on_write(rcc_cr, [](std::uint32_t, std::uint32_t &value) {
+			constexpr std::uint32_t ready = RCC_CR_HSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY | RCC_CR_PLLI2SRDY |
+											RCC_CR_PLLSAIRDY;
+			// The system clock source stays on
+			switch (sysclk_status())
+			{
+			case RCC_CFGR_SWS_HSI:
+				value |= RCC_CR_HSION;
+				break;
+			case RCC_CFGR_SWS_HSE:
+				value |= RCC_CR_HSEON;
+				break;
+			case RCC_CFGR_SWS_PLL:
+				value |= RCC_CR_PLLON;
+				break;
+			default:
+				break;
+			}
+			// Each ready flag sits one bit above its enable bit
+			value = (value & ~ready) | ((value << 1) & ready);
+		});
+
+		bus::on_write(rcc_cfgr, [](std::uint32_t, std::uint32_t &) { pending_switch_reads = switch_reads; });
+
+		bus::on_read(rcc_cfgr, [](std::uint32_t, std::uint32_t &value) {
+			if (pending_switch_reads > 0)
+			{
+				--pending_switch_reads;
+				return;
+			}
+			value = (value & ~RCC_CFGR_SWS_Msk) | ((value & RCC_CFGR_SW_Msk) << (RCC_CFGR_SWS_Pos - RCC_CFGR_SW_Pos));
+		});
+
+		bus::on_write(pwr_cr, [](std::uint32_t, std::uint32_t &value) {
+			// Over-drive is kept while the PLL is the system clock
+			if (sysclk_status() == RCC_CFGR_SWS_PLL && (at(pwr_csr) & PWR_CSR_ODSWRDY) != 0)
+			{
+				value |= PWR_CR_ODEN | PWR_CR_ODSWEN;
+			}
+			// ODRDY and ODSWRDY sit at the same positions as ODEN and ODSWEN
+			constexpr std::uint32_t ready = PWR_CSR_ODRDY | PWR_CSR_ODSWRDY;
+			at(pwr_csr) = (at(pwr_csr) & ~ready) | (value & ready);
+		});
+
+		bus::on_read(dwt_cyccnt, [](std::uint32_t, std::uint32_t &value) {
+			if (at(dwt_ctrl) & DWT_CTRL_CYCCNTENA_Msk)
+			{
+				value += cycles_per_read;
+			}
+		});
+	}
+
+	[[maybe_unused]] const bool installed = mcal::sim::add_model(install); //!< Registers the model
+} // namespace
+
+/**
+ * @brief Update SystemCoreClock from the simulated RCC registers.
+ *
+ * Same computation as the CMSIS implementation, but without bus traffic.
+ */
+void SystemCoreClockUpdate(void)
+{
+	const std::uint32_t cfgr = mcal::sim::at(rcc_cfgr);
+	const std::uint32_t pllcfgr = mcal::sim::at(rcc_pllcfgr);
+
+	switch (cfgr & RCC_CFGR_SWS_Msk)
+	{
+	case RCC_CFGR_SWS_HSE:
+		SystemCoreClock = HSE_VALUE;
+		break;
+	case RCC_CFGR_SWS_PLL: {
+		const std::uint32_t source = (pllcfgr & RCC_PLLCFGR_PLLSRC) ? HSE_VALUE : HSI_VALUE;
+		const std::uint32_t m = (pllcfgr & RCC_PLLCFGR_PLLM_Msk) >> RCC_PLLCFGR_PLLM_Pos;
+		const std::uint32_t n = (pllcfgr & RCC_PLLCFGR_PLLN_Msk) >> RCC_PLLCFGR_PLLN_Pos;
+		const std::uint32_t p = (((pllcfgr & RCC_PLLCFGR_PLLP_Msk) >> RCC_PLLCFGR_PLLP_Pos) + 1) * 2;
+		SystemCoreClock = static_cast<std::uint32_t>((static_cast<std::uint64_t>(source) / m) * n / p);
+		break;
+	}
+	default:
+		SystemCoreClock = HSI_VALUE;
+		break;
+	}
+
+	SystemCoreClock >>= AHBPrescTable[(cfgr & RCC_CFGR_HPRE_Msk) >> RCC_CFGR_HPRE_Pos];
+}
@@ -26,15 +26,33 @@
 
 #include <cstdint>
 
+/**
+ * @brief Copy table entry: RAM region initialised from its load image in flash.
+ */
+struct copy_region
+{
+	const uint32_t *src; //!< Load address (flash)
+	uint32_t *dst;		 //!< Run address (RAM)
+	uint32_t words;		 //!< Size in 32 bit words
+};
+
+/**
+ * @brief Zero table entry: RAM region cleared at startup.
+ */
+struct zero_region
+{
+	uint32_t *dst;	 //!< Run address (RAM)
+	uint32_t words; //!< Size in 32 bit words
+};
+
 /**
  * Linker script symbols
  */
-extern uint32_t _estack; /* End of SRAM */
-extern uint32_t _sdata;	 /* Start of .data section */
-extern uint32_t _edata;	 /* End of .data section */
-extern uint32_t _sidata; /* Start of .data section in FLASH */
-extern uint32_t _sbss;	 /* Start of .bss section */
-extern uint32_t _ebss;	 /* End of .bss section */
+extern uint32_t _estack;						   /* End of SRAM */
+extern const copy_region __copy_table_start__[]; /* Start of the copy table */
+extern const copy_region __copy_table_end__[];	   /* End of the copy table */
+extern const zero_region __zero_table_start__[]; /* Start of the zero table */
+extern const zero_region __zero_table_end__[];	   /* End of the zero table */
 
 /* Function declarations */
 #pragma GCC diagnostic push
@@ -45,8 +63,19 @@ extern int main(void);
 extern "C"
 {
 	extern void SystemInit(void);
+	extern void SystemCoreClockUpdate(void);
 	extern void __libc_init_array(void);
 
+	/**
+	 * @brief Hook for early board bring-up, called before .data/.bss are initialised.
+	 *
+	 * Intended to raise the core clock (flash latency + clock tree) so the rest
+	 * of the boot path, including static constructors, runs at full speed.
+	 * The hook must not depend on initialised or zeroed static storage.
+	 * Weak default does nothing.
+	 */
+	void SystemEarlyInit(void);
+
 	/**
 	 * Exception Handler declarations with weak linkage
 	 */
@@ -160,7 +189,8 @@ extern "C"
  */
 typedef void (*pFunc)(void);
 
-/* Vector table */
+/* Vector table, external linkage so interrupt.hpp can copy it to SRAM */
+extern "C" const pFunc g_pfnVectors[139];
 __attribute__((section(".isr_vector"))) const pFunc g_pfnVectors[139] = {
 	/* Cortex-M4 exceptions */
 	(pFunc)&_estack,	/*      0: End of Stack */
@@ -286,6 +316,80 @@ void Default_Handler(void)
 	{
 	}
 }
+
+__attribute__((weak)) void SystemEarlyInit(void)
+{
+}
+
+/*
+ * The region loops must not be turned into memcpy/memset calls: newlib-nano
+ * implements them byte-wise, and the C library is not initialised yet.
+ */
+#pragma GCC push_options
+#pragma GCC optimize("no-tree-loop-distribute-patterns")
+
+/**
+ * @brief Copy a word aligned region.
+ *
+ * Moves four words per iteration, which the compiler turns into LDM/STM bursts.
+ */
+static inline __attribute__((always_inline)) void copy_words(const uint32_t *src, uint32_t *dst, uint32_t words)
+{
+	for (; words >= 4; words -= 4, src += 4, dst += 4)
+	{
+		const uint32_t a = src[0];
+		const uint32_t b = src[1];
+		const uint32_t c = src[2];
+		const uint32_t d = src[3];
+		dst[0] = a;
+		dst[1] = b;
+		dst[2] = c;
+		dst[3] = d;
+	}
+	for (; words > 0; --words)
+	{
+		*dst++ = *src++;
+	}
+}
+
+/**
+ * @brief Zero a word aligned region.
+ *
+ * Clears four words per iteration, which the compiler turns into STM bursts.
+ */
+static inline __attribute__((always_inline)) void zero_words(uint32_t *dst, uint32_t words)
+{
+	for (; words >= 4; words -= 4, dst += 4)
+	{
+		dst[0] = 0;
+		dst[1] = 0;
+		dst[2] = 0;
+		dst[3] = 0;
+	}
+	for (; words > 0; --words)
+	{
+		*dst++ = 0;
+	}
+}
+
+/**
+ * @brief Initialise all RAM regions listed in the linker tables.
+ */
+static void init_memory_regions(void)
+{
+	for (const copy_region *region = __copy_table_start__; region < __copy_table_end__; ++region)
+	{
+		copy_words(region->src, region->dst, region->words);
+	}
+
+	for (const zero_region *region = __zero_table_start__; region < __zero_table_end__; ++region)
+	{
+		zero_words(region->dst, region->words);
+	}
+}
+
+#pragma GCC pop_options
+
 /**
  * @brief  This is the code that gets called when the processor first
  *          starts execution following a reset event. Only the absolutely
@@ -296,27 +400,17 @@ void Default_Handler(void)
  */
 void Reset_Handler(void)
 {
-	/* Copy the data segment initializers from flash to SRAM */
-	uint8_t *src = reinterpret_cast<uint8_t *>(&_sidata);
-	uint8_t *dst = reinterpret_cast<uint8_t *>(&_sdata);
-	uint8_t *dst_end = reinterpret_cast<uint8_t *>(&_edata);
-
-	while (dst < dst_end)
-	{
-		*dst++ = *src++;
-	}
+	/* Call the clock system initialization function (FPU access, vector table) */
+	SystemInit();
 
-	/* Zero fill the bss segment */
-	dst = reinterpret_cast<uint8_t *>(&_sbss);
-	dst_end = reinterpret_cast<uint8_t *>(&_ebss);
+	/* Early board bring-up, e.g. switch to the target clock */
+	SystemEarlyInit();
 
-	while (dst < dst_end)
-	{
-		*dst++ = 0;
-	}
+	/* Copy the data segments and RAM functions from flash and zero fill the bss segments */
+	init_memory_regions();
 
-	/* Call the clock system initialization function */
-	SystemInit();
+	/* SystemCoreClock lives in .data and was just reset to its initial value */
+	SystemCoreClockUpdate();
 
 	/* Call static constructors */
 	__libc_init_array();
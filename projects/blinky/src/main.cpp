@@ -1,18 +1,63 @@
 /**
  * @file main.cpp
- * @brief Simple blinky application for Nucleo-F446ZE using GPIO and DWT delay.
+ * @brief Simple blinky application for Nucleo-F446ZE using GPIO and a sleeping timer delay.
  */
 
 #include "bsp.h"
 #include "mcal.hpp"
 #include "utils.hpp"
-#include <cstdio>
 
 /**
  * @brief Use the Nucleo F446ZE board with 100 MHz system clock.
  */
 using board = bsp::nucleo_f446ze<100 * utils::unit::MHz>;
 
+/**
+ * @brief Raise the core clock before .data/.bss initialisation and static constructors.
+ */
+extern "C" void SystemEarlyInit() noexcept
+{
+	board::init_clock();
+}
+
+/**
+ * @brief User button (B1), both edges.
+ */
+using Button = stm32::f4::ExtiPin<board::B1, stm32::f4::ExtiEdge::Both>;
+
+/**
+ * @brief All interrupts of the application, served from a vector table in SRAM.
+ */
+using interrupts = stm32::f4::InterruptTable<stm32::f4::VectorTable::Sram, Button>;
+
+/**
+ * @brief Mirror the user button (B1) on the blue LED, called on both edges.
+ */
+static void on_button(void *context) noexcept
+{
+	(void)context;
+	if (board::B1::read())
+	{
+		board::LD_Blue::set();
+	}
+	else
+	{
+		board::LD_Blue::clear();
+	}
+}
+
+/**
+ * @brief Send queued ITM output while the delay waits, called before every sleep.
+ *
+ * @return true Output is left, the delay polls instead of sleeping.
+ */
+static bool drain_output() noexcept
+{
+	stm32::f4::itm::drain();
+	stm32::f4::log_sink::drain();
+	return stm32::f4::itm::pending() != 0 || stm32::f4::log_sink::pending() != 0;
+}
+
 /**
  * @brief Main entry point.
  */
@@ -20,38 +65,30 @@ int main() noexcept
 {
 	// Initialize board: clocks, GPIOs, delay, ITM
 	board::init();
+	interrupts::init();
+	Button::init(on_button);
 
 	std::uint32_t loop_counter = 0;
 
-	// Print system clock frequency via ITM/printf
-	printf("HSI:    %9lu Hz\n", board::clock::HSI_frequency.numerical_value_in(utils::unit::Hz));
-	printf("HSE:    %9lu Hz\n", board::clock::HSE_frequency.numerical_value_in(utils::unit::Hz));
-	printf("root:   %9lu Hz\n", board::clock::root_frequency().numerical_value_in(utils::unit::Hz));
-
-	printf("SysClk: %9lu Hz\n", board::clock::get_system_clock());
+	// Print the clock configuration via ITM port 0
+	stm32::f4::print<"HSI:    {:>9}\n">(board::clock::HSI_frequency);
+	stm32::f4::print<"HSE:    {:>9}\n">(board::clock::HSE_frequency);
+	stm32::f4::print<"root:   {:>9}\n">(board::clock::root_frequency());
+	stm32::f4::print<"SysClk: {:>9}\n">(board::clock::get_system_clock() * utils::unit::Hz);
 
 	while (true)
 	{
-		printf("Delay count: %lu\n", ++loop_counter);
+		// Only queued here, sent while the delay below waits
+		MCAL_LOG("Delay count: %lu\n", ++loop_counter);
 
 		// Toggle Green and Red LEDs
 		board::LD_Green::set();
 		board::LD_Red::set();
-		board::Delay::blocking(500 * utils::unit::ms);
+		board::Delay::blocking(500 * utils::unit::ms, drain_output);
 
 		board::LD_Green::clear();
 		board::LD_Red::clear();
-		board::Delay::blocking(500 * utils::unit::ms);
-
-		// Read user button (B1) and control Blue LED
-		if (board::B1::read())
-		{
-			board::LD_Blue::set();
-		}
-		else
-		{
-			board::LD_Blue::clear();
-		}
+		board::Delay::blocking(500 * utils::unit::ms, drain_output);
 	}
 
 	// Never reached
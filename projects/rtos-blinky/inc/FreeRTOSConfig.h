@@ -1,8 +1,11 @@
 #ifndef FREERTOS_CONFIG_H
 #define FREERTOS_CONFIG_H
 
+#include "system_stm32f4xx.h"
+
 #define configUSE_PREEMPTION 1
-#define configCPU_CLOCK_HZ (100000000UL)
+// Follows runtime clock profile switches, see main.cpp
+#define configCPU_CLOCK_HZ (SystemCoreClock)
 #define configTICK_RATE_HZ ((TickType_t)1000)
 #define configMAX_PRIORITIES 5
 #define configMINIMAL_STACK_SIZE ((unsigned short)128)
@@ -14,7 +17,7 @@
 #define xPortPendSVHandler PendSV_Handler
 #define xPortSysTickHandler SysTick_Handler
 
-#define configUSE_IDLE_HOOK 0
+#define configUSE_IDLE_HOOK 1
 #define configUSE_TICK_HOOK 0
 #define configUSE_16_BIT_TICKS 0
 
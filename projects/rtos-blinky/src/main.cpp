@@ -4,6 +4,7 @@
  */
 
 #include "bsp.h"
+#include "freertos.hpp"
 #include "mcal.hpp"
 #include "utils.hpp"
 #include <FreeRTOS.h>
@@ -14,22 +15,76 @@
  */
 using board = bsp::nucleo_f446ze<100 * utils::unit::MHz>;
 
+/**
+ * @brief Raise the core clock before .data/.bss initialisation and static constructors.
+ */
+extern "C" void SystemEarlyInit() noexcept
+{
+	board::init_clock();
+}
+
+/**
+ * @brief Normal and burst clock profiles.
+ */
+using profiles = board::clock_profiles<100 * utils::unit::MHz, 180 * utils::unit::MHz>;
+
+/**
+ * @brief Keep the RTOS tick at configTICK_RATE_HZ and the board timers at 1 µs ticks across clock switches.
+ */
+static void on_clock_change(utils::quantity::Hz_t hclk) noexcept
+{
+	stm32::f4::set_tick_rate(hclk, configTICK_RATE_HZ);
+	board::retune_timers<profiles>();
+}
+
+/**
+ * @brief Send buffered printf() output and clear .bss_lazy while no task is ready.
+ */
+extern "C" void vApplicationIdleHook(void)
+{
+	stm32::f4::itm::drain();
+	(void)stm32::f4::lazy_bss::zero_step();
+}
+
+/**
+ * @brief Priority of EXTI15_10, shared by the user button (PC13) with lines 10..15.
+ *
+ * Within the FreeRTOS syscall range.
+ */
+template <>
+inline constexpr std::uint8_t stm32::f4::exti_priority<EXTI15_10_IRQn> = 6;
+
+/**
+ * @brief User button, both edges.
+ */
+using Button = stm32::f4::ExtiPin<board::B1, stm32::f4::ExtiEdge::Both>;
+
+/**
+ * @brief All interrupts of the application, the handlers are the IRQHandler symbols.
+ */
+using interrupts = stm32::f4::InterruptTable<stm32::f4::VectorTable::Flash, Button>;
+
 /*-----------------------------------------------------------*/
 
 static void blue_button(void *parameters)
 {
 	(void)parameters;
+	stm32::f4::notify_on<Button>(xTaskGetCurrentTaskHandle());
 	for (;;)
 	{
+		// Run at full speed while the button is held
 		if (board::B1::read())
 		{
+			profiles::select<1>();
 			board::LD_Blue::set();
 		}
 		else
 		{
+			profiles::select<0>();
 			board::LD_Blue::clear();
 		}
-		vTaskDelay(2);
+		// Sleep until the button changes
+		(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
 	}
 }
 
@@ -52,10 +107,13 @@ static void blink_green(void *parameters)
 int main() noexcept
 {
 	board::init();
+	interrupts::init();
+	profiles::on_change(on_clock_change);
 	static StaticTask_t blueTaskTCB;
-	static StackType_t blueTaskStack[configMINIMAL_STACK_SIZE];
+	// Task stacks in SRAM2, away from DMA traffic in SRAM1
+	MCAL_STACK_SRAM2 static StackType_t blueTaskStack[configMINIMAL_STACK_SIZE];
 	static StaticTask_t greenTaskTCB;
-	static StackType_t greenTaskStack[configMINIMAL_STACK_SIZE];
+	MCAL_STACK_SRAM2 static StackType_t greenTaskStack[configMINIMAL_STACK_SIZE];
 
 	(void)xTaskCreateStatic(blue_button, "Blue button", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1U,
 							&(blueTaskStack[0]), &(blueTaskTCB));
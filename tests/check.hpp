@@ -0,0 +1,45 @@
+/**
+ * @file check.hpp
+ * @brief Minimal check helpers for the host tests (MCAL_HOST).
+ *
+ * Every test is a plain executable run by ctest; a failed CHECK() prints
+ * its location and makes the executable exit with a non-zero status.
+ */
+#pragma once
+
+#include <cstdio>
+
+namespace test
+{
+	inline int failures = 0; //!< Failed checks of this executable
+
+	/**
+	 * @brief Record the outcome of one check.
+	 */
+	inline void check(bool ok, const char *expression, const char *file, int line) noexcept
+	{
+		if (!ok)
+		{
+			++failures;
+			std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+		}
+	}
+
+	/**
+	 * @brief Exit status of the test executable.
+	 */
+	inline int result() noexcept
+	{
+		if (failures != 0)
+		{
+			std::fprintf(stderr, "%d check(s) failed\n", failures);
+			return 1;
+		}
+		return 0;
+	}
+} // namespace test
+
+/**
+ * @brief Check a condition, continues with the next check on failure.
+ */
+#define CHECK(expression) ::test::check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
@@ -0,0 +1,123 @@
+/**
+ * @file clock_test.cpp
+ * @brief Clock tree and flash bring-up against the STM32F4 device model.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "check.hpp"
+#include "clock.hpp"
+#include "flash.hpp"
+
+namespace
+{
+	using mcal::sim::at;
+
+	constexpr mcal::clock st_link_mco = {8 * utils::unit::MHz, mcal::clock::sources::clock}; //!< Nucleo HSE bypass
+
+	using clock_100 = stm32::f4::clock_tree<100 * utils::unit::MHz, st_link_mco>;
+	using clock_180 = stm32::f4::clock_tree<180 * utils::unit::MHz, st_link_mco>;
+	using clock_hse = stm32::f4::clock_tree<8 * utils::unit::MHz, st_link_mco>;
+	using flash = stm32::f4::flash<3300 * utils::unit::mV>;
+
+	constexpr stm32::f4::pll_config above_p_max =
+		stm32::f4::pll_solve(8 * utils::unit::MHz, {.P = 180'500'000 * utils::unit::Hz, .tolerance_ppm = 10'000});
+
+	static_assert(above_p_max.valid(), "Within tolerance below P_max");
+	static_assert(above_p_max.output(8 * utils::unit::MHz, above_p_max.P) <= 180 * utils::unit::MHz,
+				  "P output is limited to 180 MHz even within the tolerance");
+
+	using clock_near_168 = stm32::f4::clock_tree<168 * utils::unit::MHz, st_link_mco, {.tolerance_ppm = 20'000}>;
+
+	static_assert(clock_near_168::over_drive == (clock_near_168::hclk() > 168 * utils::unit::MHz),
+				  "Over-drive follows the actual HCLK, not the target");
+
+	constexpr std::uint32_t rcc_cr = RCC_BASE + offsetof(RCC_TypeDef, CR);			 //!< RCC_CR address
+	constexpr std::uint32_t rcc_cfgr = RCC_BASE + offsetof(RCC_TypeDef, CFGR);		 //!< RCC_CFGR address
+	constexpr std::uint32_t rcc_pllcfgr = RCC_BASE + offsetof(RCC_TypeDef, PLLCFGR); //!< RCC_PLLCFGR address
+
+	void pll_reaches_ready()
+	{
+		mcal::sim::reset();
+		CHECK(!clock_100::is_configured());
+
+		clock_100::init();
+
+		CHECK((at(rcc_cr) & RCC_CR_PLLRDY) != 0);
+		CHECK((at(rcc_cr) & RCC_CR_HSERDY) != 0);
+		CHECK((at(rcc_cfgr) & RCC_CFGR_SWS_Msk) == RCC_CFGR_SWS_PLL);
+		CHECK(clock_100::is_configured());
+		CHECK(SystemCoreClock == 100'000'000u);
+	}
+
+	void over_drive_above_168_mhz()
+	{
+		mcal::sim::reset();
+		clock_180::init();
+
+		CHECK(clock_180::regulator::is_over_drive());
+		CHECK(clock_180::is_configured());
+		CHECK(SystemCoreClock == 180'000'000u);
+	}
+
+	void profile_switch_leaves_over_drive()
+	{
+		mcal::sim::reset();
+		clock_180::init();
+		clock_100::init();
+
+		CHECK(!clock_100::regulator::is_over_drive());
+		CHECK((at(rcc_cr) & RCC_CR_PLLRDY) != 0);
+		CHECK(clock_100::is_configured());
+		CHECK(SystemCoreClock == 100'000'000u);
+
+		clock_hse::init();
+
+		CHECK((at(rcc_cr) & RCC_CR_PLLON) == 0);
+		CHECK(clock_hse::is_configured());
+		CHECK(SystemCoreClock == 8'000'000u);
+	}
+
+	void hse_without_pll()
+	{
+		mcal::sim::reset();
+		clock_hse::init();
+
+		CHECK((at(rcc_cr) & RCC_CR_PLLON) == 0);
+		CHECK((at(rcc_cfgr) & RCC_CFGR_SWS_Msk) == RCC_CFGR_SWS_HSE);
+		CHECK(clock_hse::is_configured());
+		CHECK(SystemCoreClock == 8'000'000u);
+	}
+
+	void i2s_pll_from_hse_without_main_pll()
+	{
+		mcal::sim::reset();
+		clock_hse::init();
+		clock_hse::PLL_I2S::init<stm32::f4::pll_outputs{.Q = 48 * utils::unit::MHz}>();
+
+		CHECK(clock_hse::PLL_I2S::is_ready());
+		CHECK((at(rcc_pllcfgr) & RCC_PLLCFGR_PLLSRC) != 0);
+	}
+
+	void flash_latency_follows_hclk()
+	{
+		mcal::sim::reset();
+		flash::configure<clock_180::hclk()>();
+
+		CHECK(flash::latency() == flash::wait_states(clock_180::hclk()));
+		CHECK(flash::is_configured<clock_180::hclk()>());
+		CHECK(!flash::is_configured<clock_hse::hclk()>());
+	}
+} // namespace
+
+int main()
+{
+	pll_reaches_ready();
+	over_drive_above_168_mhz();
+	profile_switch_leaves_over_drive();
+	hse_without_pll();
+	i2s_pll_from_hse_without_main_pll();
+	flash_latency_follows_hclk();
+	return test::result();
+}
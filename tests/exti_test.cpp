@@ -0,0 +1,83 @@
+/**
+ * @file exti_test.cpp
+ * @brief EXTI routing by ExtiPin and NVIC setup by the interrupt registry.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "check.hpp"
+#include "exti.hpp"
+#include "gpio.hpp"
+#include "interrupt.hpp"
+
+template <>
+inline constexpr std::uint8_t stm32::f4::exti_priority<EXTI9_5_IRQn> = 6;
+
+namespace
+{
+	using mcal::sim::at;
+	using mcal::sim::bus;
+
+	using B1 = stm32::f4::GpioPin<stm32::f4::GpioC, 13, stm32::f4::GpioPinMode::Input>;
+	using PA5 = stm32::f4::GpioPin<stm32::f4::GpioA, 5, stm32::f4::GpioPinMode::Input>;
+
+	using Button = stm32::f4::ExtiPin<B1, stm32::f4::ExtiEdge::Both>;
+	using Sensor = stm32::f4::ExtiPin<PA5, stm32::f4::ExtiEdge::Rising>;
+	using interrupts = stm32::f4::InterruptTable<stm32::f4::VectorTable::Flash, Button, Sensor>;
+
+	static_assert(Button::priority == 15, "Default priority of EXTI15_10");
+	static_assert(Sensor::priority == 6, "Priority of EXTI9_5 taken from exti_priority");
+
+	constexpr std::uint32_t exti_imr = EXTI_BASE + offsetof(EXTI_TypeDef, IMR);					//!< EXTI_IMR address
+	constexpr std::uint32_t exti_rtsr = EXTI_BASE + offsetof(EXTI_TypeDef, RTSR);				//!< EXTI_RTSR address
+	constexpr std::uint32_t exti_ftsr = EXTI_BASE + offsetof(EXTI_TypeDef, FTSR);				//!< EXTI_FTSR address
+	constexpr std::uint32_t syscfg_exticr4 = SYSCFG_BASE + offsetof(SYSCFG_TypeDef, EXTICR[3]);	//!< SYSCFG_EXTICR4 address
+	constexpr std::uint32_t nvic_iser1 = NVIC_BASE + offsetof(NVIC_Type, ISER[1]);				//!< NVIC_ISER1 address
+	constexpr std::uint32_t nvic_icpr1 = NVIC_BASE + offsetof(NVIC_Type, ICPR[1]);				//!< NVIC_ICPR1 address
+	constexpr std::uint32_t nvic_ip40 = NVIC_BASE + offsetof(NVIC_Type, IP[40]);				//!< Priority word of IRQ 40..43
+
+	void on_edge(void *context) noexcept
+	{
+		(void)context;
+	}
+
+	void prepare()
+	{
+		mcal::sim::reset();
+		bus::clear();
+	}
+
+	void pin_init_only_routes()
+	{
+		prepare();
+		Button::init(on_edge);
+
+		CHECK((at(exti_imr) & Button::mask) != 0);
+		CHECK((at(exti_rtsr) & Button::mask) != 0);
+		CHECK((at(exti_ftsr) & Button::mask) != 0);
+		CHECK(((at(syscfg_exticr4) >> Button::shift) & 0xFu) == Button::port);
+		CHECK(bus::writes(nvic_iser1) == 0);
+		CHECK(bus::writes(nvic_icpr1) == 0);
+		CHECK(bus::writes(nvic_ip40) == 0);
+	}
+
+	void registry_enables_without_clearing_pending()
+	{
+		prepare();
+		Button::init(on_edge);
+		Sensor::init(on_edge);
+		interrupts::init();
+
+		CHECK(at(nvic_iser1) == 1u << (EXTI15_10_IRQn - 32));
+		CHECK(bus::writes(nvic_icpr1) == 0);
+		CHECK((at(nvic_ip40) & 0xFFu) == 15u << (8u - stm32::f4::nvic::priority_bits));
+	}
+} // namespace
+
+int main()
+{
+	pin_init_only_routes();
+	registry_enables_without_clearing_pending();
+	return test::result();
+}
@@ -0,0 +1,139 @@
+/**
+ * @file format_test.cpp
+ * @brief Exact output of the compile-time checked formatter.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+#include "format.hpp"
+#include "units.hpp"
+
+namespace
+{
+	using mcal::format::max_size;
+
+	enum class mode : std::uint8_t
+	{
+		idle = 3,
+	};
+
+	/**
+	 * @brief Format into a guarded buffer and compare with the expected text.
+	 *
+	 * Fails as well if more than max_size characters are written.
+	 */
+	template <mcal::format::string Format, typename... Args>
+	bool formats(std::string_view expected, const Args &...args)
+	{
+		constexpr std::size_t size = max_size<Format, Args...>;
+		constexpr std::size_t guard = 16;
+		std::array<char, size + guard> buffer;
+		buffer.fill('#');
+
+		const char *end = mcal::format::format_to<Format>(buffer.data(), args...);
+		const auto length = static_cast<std::size_t>(end - buffer.data());
+
+		bool guard_intact = true;
+		for (std::size_t i = size; i < buffer.size(); ++i)
+		{
+			guard_intact = guard_intact && buffer[i] == '#';
+		}
+		return length <= size && guard_intact && std::string_view{buffer.data(), length} == expected;
+	}
+
+	void literals_and_braces()
+	{
+		CHECK(formats<"plain">("plain"));
+		CHECK(formats<"{{}}">("{}"));
+		CHECK(formats<"{{{}}}">("{7}", 7));
+		CHECK(formats<"a{}b{}c">("a1b2c", 1, 2));
+	}
+
+	void fill_and_align()
+	{
+		CHECK(formats<"{:6}">("    42", 42));
+		CHECK(formats<"{:<6}">("42    ", 42));
+		CHECK(formats<"{:*<6}">("42****", 42));
+		CHECK(formats<"{:_^7}">("__ab___", "ab"));
+		CHECK(formats<"{:6}">("ab    ", "ab"));
+		CHECK(formats<"{:>6}">("    ab", std::string_view{"ab"}));
+		CHECK(formats<"{:-^5}">("--x--", 'x'));
+		CHECK(formats<"{:2}">("12345", 12345));
+	}
+
+	void zero_padding()
+	{
+		CHECK(formats<"{:06}">("000042", 42));
+		CHECK(formats<"{:06}">("-00042", -42));
+		CHECK(formats<"{:08b}">("00000101", 5u));
+		CHECK(formats<"{:04X}">("00AB", 0xABu));
+	}
+
+	void integers()
+	{
+		CHECK(formats<"{}">("0", 0));
+		CHECK(formats<"{}">("-2147483648", std::numeric_limits<std::int32_t>::min()));
+		CHECK(formats<"{}">("4294967295", std::numeric_limits<std::uint32_t>::max()));
+		CHECK(formats<"{}">("-9223372036854775808", std::numeric_limits<std::int64_t>::min()));
+		CHECK(formats<"{}">("18446744073709551615", std::numeric_limits<std::uint64_t>::max()));
+		CHECK(formats<"{:x}">("beef", 0xBEEFu));
+		CHECK(formats<"{:X}">("BEEF", 0xBEEFu));
+		CHECK(formats<"{:b}">("1111111111111111111111111111111111111111111111111111111111111111",
+							  std::numeric_limits<std::uint64_t>::max()));
+		CHECK(formats<"{:x}">("ffffff80", static_cast<std::uint32_t>(-128)));
+		CHECK(formats<"{}">("-128", std::int8_t{-128}));
+		CHECK(formats<"{}">("3", mode::idle));
+	}
+
+	void characters_and_text()
+	{
+		CHECK(formats<"{:c}">("A", 65));
+		CHECK(formats<"{}">("z", 'z'));
+		CHECK(formats<"{:d}">("122", 'z'));
+		CHECK(formats<"{}">("true", true));
+		CHECK(formats<"{:>6}">(" false", false));
+
+		const char *none = nullptr;
+		CHECK(formats<"{}">("(null)", none));
+
+		std::array<char, 101> long_text{};
+		long_text.fill('t');
+		long_text.back() = '\0';
+		const char *text = long_text.data();
+		CHECK(formats<"[{}]">("[" + std::string(mcal::format::max_string, 't') + "]", text));
+	}
+
+	void quantities()
+	{
+		const utils::quantity::Hz_t hclk = 180 * utils::unit::MHz;
+		const utils::quantity::mv_t supply = 3300 * utils::unit::mV;
+
+		CHECK(formats<"{}">("180000000 Hz", hclk));
+		CHECK(formats<"{:>10}">(" 180000000 Hz", hclk));
+		CHECK(formats<"{:06}">("003300 mV", supply));
+	}
+
+	static_assert(max_size<"{}", std::int32_t> == 11, "Sign and ten digits");
+	static_assert(max_size<"{}", std::uint64_t> == 20, "Twenty digits");
+	static_assert(max_size<"{:x}", std::uint32_t> == 8, "Eight hex digits");
+	static_assert(max_size<"{:12}", std::uint8_t> == 12, "Width exceeds the digits");
+	static_assert(max_size<"{}", const char *> == mcal::format::max_string, "Text is truncated");
+	static_assert(max_size<"{{}}"> == 2, "One character per doubled brace");
+} // namespace
+
+int main()
+{
+	literals_and_braces();
+	fill_and_align();
+	zero_padding();
+	integers();
+	characters_and_text();
+	quantities();
+	return test::result();
+}
@@ -0,0 +1,109 @@
+/**
+ * @file gpio_test.cpp
+ * @brief Bus transactions of the GPIO driver.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "check.hpp"
+#include "gpio.hpp"
+
+namespace
+{
+	using mcal::sim::at;
+	using mcal::sim::bus;
+
+	using Led = stm32::f4::GpioPin<stm32::f4::GpioB, 7, stm32::f4::GpioPinMode::Output>;
+	using Other = stm32::f4::GpioPin<stm32::f4::GpioB, 14, stm32::f4::GpioPinMode::Output>;
+	using Button = stm32::f4::GpioPin<stm32::f4::GpioC, 13, stm32::f4::GpioPinMode::Input>;
+	using Bus = stm32::f4::GpioPortMask<stm32::f4::GpioD, 0, 1, 2, 3>;
+
+	constexpr std::uint32_t gpiob_bsrr = GPIOB_BASE + offsetof(GPIO_TypeDef, BSRR);	  //!< GPIOB_BSRR address
+	constexpr std::uint32_t gpiob_odr = GPIOB_BASE + offsetof(GPIO_TypeDef, ODR);	  //!< GPIOB_ODR address
+	constexpr std::uint32_t gpiob_moder = GPIOB_BASE + offsetof(GPIO_TypeDef, MODER); //!< GPIOB_MODER address
+	constexpr std::uint32_t gpioc_idr = GPIOC_BASE + offsetof(GPIO_TypeDef, IDR);	  //!< GPIOC_IDR address
+	constexpr std::uint32_t gpiod_bsrr = GPIOD_BASE + offsetof(GPIO_TypeDef, BSRR);	  //!< GPIOD_BSRR address
+	constexpr std::uint32_t rcc_ahb1enr = RCC_BASE + offsetof(RCC_TypeDef, AHB1ENR);  //!< RCC_AHB1ENR address
+
+	void prepare()
+	{
+		mcal::sim::reset();
+		bus::clear();
+	}
+
+	void set_is_one_store()
+	{
+		prepare();
+		Led::set();
+
+		CHECK(bus::writes() == 1);
+		CHECK(bus::reads() == 0);
+		CHECK(at(gpiob_bsrr) == (1u << 7));
+	}
+
+	void clear_is_one_store()
+	{
+		prepare();
+		Led::clear();
+
+		CHECK(bus::writes() == 1);
+		CHECK(bus::reads() == 0);
+		CHECK(at(gpiob_bsrr) == (1u << (7 + 16)));
+	}
+
+	void toggle_reads_odr_once()
+	{
+		prepare();
+		at(gpiob_odr) = 1u << 7;
+		Led::toggle();
+
+		CHECK(bus::reads(gpiob_odr) == 1);
+		CHECK(bus::writes() == 1);
+		CHECK(at(gpiob_bsrr) == (1u << (7 + 16)));
+	}
+
+	void read_is_one_load()
+	{
+		prepare();
+		at(gpioc_idr) = 1u << 13;
+
+		CHECK(Button::read());
+		CHECK(bus::reads() == 1);
+		CHECK(bus::writes() == 0);
+	}
+
+	void port_mask_write_is_one_store()
+	{
+		prepare();
+		Bus::write(0b0101);
+
+		CHECK(bus::writes() == 1);
+		CHECK(bus::reads() == 0);
+		CHECK(at(gpiod_bsrr) == ((0b1010u << 16) | 0b0101u));
+	}
+
+	void config_coalesces_per_port()
+	{
+		prepare();
+		stm32::f4::GpioConfig<Led, Other, Button>::init();
+
+		// One clock update for both ports, one MODER update for both GPIOB pins
+		CHECK(bus::writes(rcc_ahb1enr) == 1);
+		CHECK(bus::writes(gpiob_moder) == 1);
+		CHECK((at(rcc_ahb1enr) & (RCC_AHB1ENR_GPIOBEN | RCC_AHB1ENR_GPIOCEN)) ==
+			  (RCC_AHB1ENR_GPIOBEN | RCC_AHB1ENR_GPIOCEN));
+		CHECK(at(gpiob_moder) == ((0b01u << (7 * 2)) | (0b01u << (14 * 2))));
+	}
+} // namespace
+
+int main()
+{
+	set_is_one_store();
+	clear_is_one_store();
+	toggle_reads_odr_once();
+	read_is_one_load();
+	port_mask_write_is_one_store();
+	config_coalesces_per_port();
+	return test::result();
+}
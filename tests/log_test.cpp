@@ -0,0 +1,164 @@
+/**
+ * @file log_test.cpp
+ * @brief Frame bytes of the tokenised log, as read by tools/logdecode.py.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "log.hpp"
+
+namespace
+{
+	/**
+	 * @brief Sink keeping the last frame.
+	 */
+	struct capture
+	{
+		static inline std::vector<std::uint8_t> frame; //!< Bytes of the last write
+		static inline unsigned writes = 0;			   //!< Number of writes
+
+		static void write(std::span<const std::uint8_t> data) noexcept
+		{
+			frame.assign(data.begin(), data.end());
+			++writes;
+		}
+	};
+
+	enum class state : std::uint8_t
+	{
+		running = 2,
+	};
+
+	/**
+	 * @brief Fixed token, emit() never dereferences the format string.
+	 */
+	const char *token(std::uintptr_t address)
+	{
+		return reinterpret_cast<const char *>(address);
+	}
+
+	/**
+	 * @brief Compare the last frame with the expected bytes.
+	 */
+	bool sent(std::initializer_list<std::uint8_t> expected)
+	{
+		return std::equal(capture::frame.begin(), capture::frame.end(), expected.begin(), expected.end());
+	}
+
+	static_assert(mcal::log::varint_size(0x7F) == 1, "7 bits per byte");
+	static_assert(mcal::log::varint_size(0x80) == 2, "7 bits per byte");
+	static_assert(mcal::log::varint_size(0xFFFF'FFFFu) == 5, "32 bits in five bytes");
+	static_assert(mcal::log::max_encoded_size<std::int8_t>() == 4, "Promoted to 32 bit");
+	static_assert(mcal::log::max_encoded_size<std::uint64_t>() == 8, "64 bit integer");
+	static_assert(mcal::log::max_encoded_size<float>() == 8, "Promoted to double");
+	static_assert(mcal::log::max_encoded_size<const char *>() == 1 + mcal::log::max_string, "Length and text");
+
+	void header()
+	{
+		// Length covers the token and the arguments
+		mcal::log::emit<capture>(token(0x34));
+		CHECK(sent({0x01, 0x34}));
+
+		mcal::log::emit<capture>(token(0x1234));
+		CHECK(sent({0x02, 0xB4, 0x24}));
+
+		mcal::log::emit<capture>(token(0xF000'0000));
+		CHECK(sent({0x05, 0x80, 0x80, 0x80, 0x80, 0x0F}));
+		CHECK(capture::writes == 3);
+	}
+
+	void small_integers()
+	{
+		// %d, %u, %x: four bytes, signed types sign extended
+		mcal::log::emit<capture>(token(0x10), std::int8_t{-1}, std::int16_t{-2}, -3);
+		CHECK(sent({0x0D, 0x10, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF, 0xFF, 0xFD, 0xFF, 0xFF, 0xFF}));
+
+		mcal::log::emit<capture>(token(0x10), std::uint8_t{0xFF}, std::uint16_t{0x8001}, 0x8000'0000u);
+		CHECK(sent({0x0D, 0x10, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80}));
+
+		mcal::log::emit<capture>(token(0x10), true, state::running, 'A');
+		CHECK(sent({0x0D, 0x10, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00}));
+	}
+
+	void wide_integers()
+	{
+		// %lld, %llu: eight bytes
+		mcal::log::emit<capture>(token(0x10), std::int64_t{-2});
+		CHECK(sent({0x09, 0x10, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}));
+
+		mcal::log::emit<capture>(token(0x10), std::uint64_t{0x0123'4567'89AB'CDEF});
+		CHECK(sent({0x09, 0x10, 0xEF, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0x01}));
+	}
+
+	void floating_point()
+	{
+		// %f: double, floats promoted
+		mcal::log::emit<capture>(token(0x10), 1.5, 0.5f);
+		CHECK(sent({0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00,
+					0x00, 0xE0, 0x3F}));
+	}
+
+	void pointers()
+	{
+		// %p: four bytes
+		mcal::log::emit<capture>(token(0x10), reinterpret_cast<const void *>(std::uintptr_t{0x2000'1000}));
+		CHECK(sent({0x05, 0x10, 0x00, 0x10, 0x00, 0x20}));
+	}
+
+	void strings()
+	{
+		// %s: varint length, then the bytes without terminator
+		const char *text = "abc";
+		mcal::log::emit<capture>(token(0x10), text);
+		CHECK(sent({0x05, 0x10, 0x03, 'a', 'b', 'c'}));
+
+		const char *none = nullptr;
+		mcal::log::emit<capture>(token(0x10), none, "");
+		CHECK(sent({0x03, 0x10, 0x00, 0x00}));
+	}
+
+	void long_strings()
+	{
+		const std::string text(100, 'x');
+		const std::string truncated(mcal::log::max_string, 'x');
+
+		// Truncated to max_string, frame longer than one varint byte
+		mcal::log::emit<capture>(token(0x10), text.c_str(), text.c_str());
+		std::vector<std::uint8_t> expected{0x83, 0x01, 0x10, 0x40};
+		expected.insert(expected.end(), truncated.begin(), truncated.end());
+		expected.push_back(0x40);
+		expected.insert(expected.end(), truncated.begin(), truncated.end());
+		CHECK(capture::frame == expected);
+	}
+
+	void macro()
+	{
+		MCAL_LOG_TO(capture, "%d %s", -1, "ok");
+
+		// Length, token of the static format string, arguments
+		const std::size_t size = capture::frame.size();
+		CHECK(size > 8);
+		CHECK(capture::frame[0] == size - 1);
+		CHECK(std::equal(capture::frame.end() - 7, capture::frame.end(),
+						 std::initializer_list<std::uint8_t>{0xFF, 0xFF, 0xFF, 0xFF, 0x02, 'o', 'k'}.begin()));
+	}
+} // namespace
+
+int main()
+{
+	header();
+	small_integers();
+	wide_integers();
+	floating_point();
+	pointers();
+	strings();
+	long_strings();
+	macro();
+	return test::result();
+}
@@ -0,0 +1,101 @@
+/**
+ * @file register_test.cpp
+ * @brief Bus transactions of the Register helpers.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "check.hpp"
+#include "device.hpp"
+#include "mcal.hpp"
+
+namespace
+{
+	using mcal::sim::at;
+	using mcal::sim::bus;
+
+	constexpr std::uint32_t pllcfgr = RCC_BASE + offsetof(RCC_TypeDef, PLLCFGR); //!< Register used for the tests
+
+	using PLLM = RegisterField<RCC_PLLCFGR_PLLM_Msk, RCC_PLLCFGR_PLLM_Pos>;
+	using PLLN = RegisterField<RCC_PLLCFGR_PLLN_Msk, RCC_PLLCFGR_PLLN_Pos>;
+
+	void prepare(std::uint32_t value)
+	{
+		mcal::sim::reset();
+		at(pllcfgr) = value;
+		bus::clear();
+	}
+
+	void modify_is_one_read_modify_write()
+	{
+		prepare(0xFFFF'FFFFu);
+		Register::modify<PLLM::value<8>(), PLLN::value<336>()>(RCC->PLLCFGR);
+
+		CHECK(bus::reads() == 1);
+		CHECK(bus::writes() == 1);
+		CHECK(PLLM::get(RCC->PLLCFGR) == 8);
+		CHECK(PLLN::get(RCC->PLLCFGR) == 336);
+		CHECK((at(pllcfgr) & ~(PLLM::mask | PLLN::mask)) == ~(PLLM::mask | PLLN::mask));
+	}
+
+	void modify_of_whole_register_skips_load()
+	{
+		prepare(0x1234'5678u);
+		Register::modify<RegisterValue{0x2400'3010u, 0xFFFF'FFFFu}>(RCC->PLLCFGR);
+
+		CHECK(bus::reads() == 0);
+		CHECK(bus::writes() == 1);
+		CHECK(at(pllcfgr) == 0x2400'3010u);
+	}
+
+	void empty_modify_has_no_access()
+	{
+		prepare(0x1234'5678u);
+		Register::modify<>(RCC->PLLCFGR);
+
+		CHECK(bus::reads() == 0);
+		CHECK(bus::writes() == 0);
+	}
+
+	void runtime_modify_is_one_read_modify_write()
+	{
+		prepare(0);
+		Register::modify(RCC->PLLCFGR, PLLM::make(4), PLLN::make(180));
+
+		CHECK(bus::reads() == 1);
+		CHECK(bus::writes() == 1);
+		CHECK(at(pllcfgr) == ((4u << RCC_PLLCFGR_PLLM_Pos) | (180u << RCC_PLLCFGR_PLLN_Pos)));
+	}
+
+	void store_does_not_load()
+	{
+		prepare(0x1234'5678u);
+		Register::store(RCC->PLLCFGR, 0xA5u);
+
+		CHECK(bus::reads() == 0);
+		CHECK(bus::writes() == 1);
+		CHECK(at(pllcfgr) == 0xA5u);
+	}
+
+	void write_keeps_other_bits()
+	{
+		prepare(0b0000'1111u);
+		Register::write<0b0000'1000u, 0b0000'1100u>(RCC->PLLCFGR);
+
+		CHECK(bus::reads() == 1);
+		CHECK(bus::writes() == 1);
+		CHECK(at(pllcfgr) == 0b0000'1011u);
+	}
+} // namespace
+
+int main()
+{
+	modify_is_one_read_modify_write();
+	modify_of_whole_register_skips_load();
+	empty_modify_has_no_access();
+	runtime_modify_is_one_read_modify_write();
+	store_does_not_load();
+	write_keeps_other_bits();
+	return test::result();
+}
@@ -0,0 +1,165 @@
+/**
+ * @file ring_buffer_test.cpp
+ * @brief Wrap-around, overflow policies and accounting of the ring buffer.
+ */
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "check.hpp"
+#include "ring_buffer.hpp"
+
+namespace
+{
+	template <std::size_t N>
+	using bytes = std::array<std::uint8_t, N>;
+
+	/**
+	 * @brief Compare a chunk with the expected bytes.
+	 */
+	template <std::size_t N>
+	bool equals(std::span<const std::uint8_t> chunk, const bytes<N> &expected)
+	{
+		if (chunk.size() != N)
+			return false;
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			if (chunk[i] != expected[i])
+				return false;
+		}
+		return true;
+	}
+
+	void empty()
+	{
+		mcal::ring_buffer<8> buffer;
+
+		CHECK(buffer.size() == 0);
+		CHECK(buffer.peek().empty());
+		CHECK(buffer.dropped() == 0);
+	}
+
+	void wrap_around()
+	{
+		mcal::ring_buffer<8> buffer;
+
+		CHECK(buffer.write(bytes<6>{1, 2, 3, 4, 5, 6}) == 6);
+		buffer.consume(buffer.peek().size());
+		CHECK(buffer.size() == 0);
+
+		// Occupies offsets 6, 7, 0, 1, 2
+		CHECK(buffer.write(bytes<5>{10, 11, 12, 13, 14}) == 5);
+		CHECK(buffer.size() == 5);
+
+		// The first chunk ends at the end of the storage
+		CHECK(equals(buffer.peek(), bytes<2>{10, 11}));
+		buffer.consume(2);
+		CHECK(buffer.size() == 3);
+
+		CHECK(equals(buffer.peek(), bytes<3>{12, 13, 14}));
+		buffer.consume(3);
+		CHECK(buffer.size() == 0);
+		CHECK(buffer.peek().empty());
+	}
+
+	void partial_consume()
+	{
+		mcal::ring_buffer<8> buffer;
+
+		CHECK(buffer.write(bytes<4>{1, 2, 3, 4}) == 4);
+		buffer.consume(1);
+		CHECK(equals(buffer.peek(), bytes<3>{2, 3, 4}));
+		CHECK(buffer.size() == 3);
+	}
+
+	void full()
+	{
+		mcal::ring_buffer<8> buffer;
+
+		CHECK(buffer.write(bytes<3>{1, 2, 3}) == 3);
+		buffer.consume(3);
+
+		// Full buffer starting at offset 3
+		CHECK(buffer.write(bytes<8>{1, 2, 3, 4, 5, 6, 7, 8}) == 8);
+		CHECK(buffer.size() == 8);
+		CHECK(buffer.dropped() == 0);
+
+		CHECK(buffer.write(bytes<1>{9}) == 0);
+		CHECK(buffer.size() == 8);
+		CHECK(buffer.dropped() == 1);
+
+		CHECK(equals(buffer.peek(), bytes<5>{1, 2, 3, 4, 5}));
+		buffer.consume(5);
+		CHECK(equals(buffer.peek(), bytes<3>{6, 7, 8}));
+		buffer.consume(3);
+		CHECK(buffer.size() == 0);
+	}
+
+	void drop_policy()
+	{
+		mcal::ring_buffer<8, mcal::overflow::drop> buffer;
+
+		CHECK(buffer.write(bytes<5>{1, 2, 3, 4, 5}) == 5);
+
+		// Whole record dropped, nothing torn
+		CHECK(buffer.write(bytes<4>{6, 7, 8, 9}) == 0);
+		CHECK(buffer.size() == 5);
+		CHECK(buffer.dropped() == 4);
+
+		// A record that fits still goes in
+		CHECK(buffer.write(bytes<3>{6, 7, 8}) == 3);
+		CHECK(buffer.size() == 8);
+		CHECK(buffer.dropped() == 4);
+
+		CHECK(buffer.write(bytes<2>{9, 10}) == 0);
+		CHECK(buffer.dropped() == 6);
+		CHECK(equals(buffer.peek(), bytes<8>{1, 2, 3, 4, 5, 6, 7, 8}));
+	}
+
+	void truncate_policy()
+	{
+		mcal::ring_buffer<8, mcal::overflow::truncate> buffer;
+
+		CHECK(buffer.write(bytes<5>{1, 2, 3, 4, 5}) == 5);
+
+		// Only the part that fits is dropped
+		CHECK(buffer.write(bytes<4>{6, 7, 8, 9}) == 3);
+		CHECK(buffer.size() == 8);
+		CHECK(buffer.dropped() == 1);
+		CHECK(equals(buffer.peek(), bytes<8>{1, 2, 3, 4, 5, 6, 7, 8}));
+
+		CHECK(buffer.write(bytes<2>{10, 11}) == 0);
+		CHECK(buffer.dropped() == 3);
+
+		buffer.consume(2);
+		CHECK(buffer.write(bytes<3>{12, 13, 14}) == 2);
+		CHECK(buffer.dropped() == 4);
+		CHECK(buffer.size() == 8);
+
+		CHECK(equals(buffer.peek(), bytes<6>{3, 4, 5, 6, 7, 8}));
+		buffer.consume(6);
+		CHECK(equals(buffer.peek(), bytes<2>{12, 13}));
+	}
+
+	void empty_write()
+	{
+		mcal::ring_buffer<8> buffer;
+
+		CHECK(buffer.write({}) == 0);
+		CHECK(buffer.size() == 0);
+		CHECK(buffer.dropped() == 0);
+	}
+} // namespace
+
+int main()
+{
+	empty();
+	wrap_around();
+	partial_consume();
+	full();
+	drop_policy();
+	truncate_policy();
+	empty_write();
+	return test::result();
+}
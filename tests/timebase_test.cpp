@@ -0,0 +1,59 @@
+/**
+ * @file timebase_test.cpp
+ * @brief µs timers of the board following clock profile switches.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bsp.h"
+#include "check.hpp"
+
+namespace
+{
+	using mcal::sim::at;
+
+	using board = bsp::nucleo_f446ze<100 * utils::unit::MHz>;
+	using profiles = board::clock_profiles<100 * utils::unit::MHz, 180 * utils::unit::MHz>;
+
+	constexpr std::uint32_t tim2_psc = TIM2_BASE + offsetof(TIM_TypeDef, PSC); //!< TIM2_PSC address
+	constexpr std::uint32_t tim2_cnt = TIM2_BASE + offsetof(TIM_TypeDef, CNT); //!< TIM2_CNT address
+
+	void init_does_not_start_timebase()
+	{
+		mcal::sim::reset();
+		board::init();
+
+		CHECK(!board::Timebase::is_running());
+	}
+
+	void timebase_follows_profile_switch()
+	{
+		mcal::sim::reset();
+		board::init();
+		board::Timebase::init();
+		CHECK(at(tim2_psc) == stm32::f4::us_timer_prescaler(board::clock::timer_clock1()));
+
+		at(tim2_cnt) = 1234u;
+		profiles::select<1>();
+		board::retune_timers<profiles>();
+
+		CHECK(at(tim2_psc) == stm32::f4::us_timer_prescaler(profiles::timer_clocks1[1]));
+		CHECK(at(tim2_cnt) == 1234u);
+		CHECK(board::Timebase::now() == 1234 * utils::unit::us);
+
+		profiles::select<0>();
+		board::retune_timers<profiles>();
+
+		CHECK(at(tim2_psc) == stm32::f4::us_timer_prescaler(profiles::timer_clocks1[0]));
+	}
+} // namespace
+
+int main()
+{
+	static_assert(profiles::timer_clocks1[0] != profiles::timer_clocks1[1]);
+
+	init_does_not_start_timebase();
+	timebase_follows_profile_switch();
+	return test::result();
+}
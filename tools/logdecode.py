@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""Decode tokenised MCAL_LOG output back to text.
+
+The firmware sends frames of
+
+    varint length | varint token | argument bytes ...
+
+where the token is the address of the format string within the
+non-loaded .mcal_log section of the ELF file (see mcal/inc/log.hpp).
+This tool reads the format strings from the ELF file and formats the
+arguments on the host.
+
+The input is either the plain byte stream of the log stimulus port
+(default) or a raw ITM/SWO capture (--itm), from which the packets of
+--port are extracted.
+
+Usage:
+    logdecode.py <firmware.elf> <capture.bin> [--itm] [--port 1]
+    openocd ... | logdecode.py firmware.elf - --itm
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SECTION = ".mcal_log"
+
+# printf conversion: flags, width, precision, length modifier, conversion
+SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L|q)?([diouxXcsfFeEgGaAp%])")
+
+
+def read_section(path, name):
+    """Return (address, bytes) of a section of an ELF file."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF":
+        sys.exit(f"logdecode: {path} is not an ELF file")
+    is64 = elf[4] == 2
+    endian = "<" if elf[5] == 1 else ">"
+    if is64:
+        shoff, = struct.unpack_from(endian + "Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x3A)
+    else:
+        shoff, = struct.unpack_from(endian + "I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x2E)
+
+    def header(index):
+        base = shoff + index * shentsize
+        if is64:
+            sh_name, _, _, addr, offset, size = struct.unpack_from(endian + "IIQQQQ", elf, base)
+        else:
+            sh_name, _, _, addr, offset, size = struct.unpack_from(endian + "IIIIII", elf, base)
+        return sh_name, addr, offset, size
+
+    _, _, str_offset, _ = header(shstrndx)
+    for index in range(shnum):
+        sh_name, addr, offset, size = header(index)
+        end = elf.index(b"\0", str_offset + sh_name)
+        if elf[str_offset + sh_name:end].decode() == name:
+            return addr, elf[offset:offset + size]
+    sys.exit(f"logdecode: {path} has no {name} section, is MCAL_LOG used?")
+
+
+def varint(data, pos):
+    value = shift = 0
+    while True:
+        if pos >= len(data):
+            raise IndexError
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte < 0x80:
+            return value, pos
+
+
+def itm_payload(data, port):
+    """Extract the bytes of one stimulus port from a raw ITM stream."""
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        header = data[pos]
+        pos += 1
+        if header in (0x00, 0x80):
+            continue  # synchronisation
+        size = header & 0x03
+        if size == 0:
+            # overflow, timestamp and extension packets: skip continuation bytes
+            if header & 0x80:
+                while pos < len(data) and data[pos] & 0x80:
+                    pos += 1
+                pos += 1
+            continue
+        length = {1: 1, 2: 2, 3: 4}[size]
+        payload = data[pos:pos + length]
+        pos += length
+        if not header & 0x04 and header >> 3 == port:
+            out += payload
+    return bytes(out)
+
+
+def convert(spec, data, pos):
+    """Decode one argument for a printf conversion and format it."""
+    flags, width, precision, length, conversion = spec.groups()
+    python = "%" + (flags or "") + (width or "") + ("." + precision if precision is not None else "")
+    if conversion in "diouxXc":
+        if length in ("ll", "q", "j"):
+            raw, = struct.unpack_from("<Q", data, pos)
+            pos += 8
+            bits = 64
+        else:
+            raw, = struct.unpack_from("<I", data, pos)
+            pos += 4
+            bits = 32
+        if conversion in "di" and raw >> (bits - 1):
+            raw -= 1 << bits
+        if conversion == "u":
+            conversion = "d"
+        return (python + conversion) % raw, pos
+    if conversion in "fFeEgGaA":
+        value, = struct.unpack_from("<d", data, pos)
+        pos += 8
+        if conversion in "aA":
+            return value.hex(), pos
+        return (python + conversion) % value, pos
+    if conversion == "s":
+        size, pos = varint(data, pos)
+        text = data[pos:pos + size].decode("utf-8", "replace")
+        return (python + "s") % text, pos + size
+    # pointer
+    value, = struct.unpack_from("<I", data, pos)
+    return f"0x{value:08x}", pos + 4
+
+
+def render(fmt, args):
+    out = []
+    pos = 0
+    last = 0
+    for spec in SPEC.finditer(fmt):
+        out.append(fmt[last:spec.start()])
+        last = spec.end()
+        if spec.group(5) == "%":
+            out.append("%")
+        else:
+            text, pos = convert(spec, args, pos)
+            out.append(text)
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def decode(stream, section_address, strings):
+    pos = 0
+    while pos < len(stream):
+        try:
+            length, body = varint(stream, pos)
+            frame = stream[body:body + length]
+            if len(frame) < length:
+                break
+            token, args = varint(frame, 0)
+            offset = token - section_address
+            if not 0 <= offset < len(strings):
+                raise ValueError(f"unknown token {token:#x}")
+            fmt = strings[offset:strings.index(b"\0", offset)].decode("utf-8", "replace")
+            yield render(fmt, frame[args:])
+            pos = body + length
+        except (IndexError, ValueError, struct.error) as error:
+            # Lost synchronisation: skip one byte and try again
+            print(f"logdecode: {error}, resynchronising", file=sys.stderr)
+            pos += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF file with the .mcal_log section")
+    parser.add_argument("capture", help="captured log stream, - for stdin")
+    parser.add_argument("--itm", action="store_true", help="input is a raw ITM/SWO stream")
+    parser.add_argument("--port", type=int, default=1, help="ITM stimulus port of the log (default: 1)")
+    args = parser.parse_args()
+
+    address, strings = read_section(args.elf, SECTION)
+    if args.capture == "-":
+        stream = sys.stdin.buffer.read()
+    else:
+        with open(args.capture, "rb") as f:
+            stream = f.read()
+    if args.itm:
+        stream = itm_payload(stream, args.port)
+
+    for line in decode(stream, address, strings):
+        sys.stdout.write(line)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+"""Generate a typed C++ register map from a CMSIS SVD file.
+
+The generated header describes every peripheral register as
+mcal::svd::reg and every bit field as mcal::svd::field (see
+mcal/inc/svd.hpp), including address, reset value, reserved bits and
+access policy.
+
+Layout of the generated code:
+
+    namespace <namespace>::<peripheral in lower case>::<REGISTER>
+    {
+        using reg = mcal::svd::reg<...>;          // the register itself
+        using <FIELD> = mcal::svd::field<reg, ...>; // one per bit field
+    }
+
+Usage:
+    svd2hpp.py <input.svd> <output.hpp> [--namespace stm32::f4::svd]
+"""
+
+import argparse
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+CPP_KEYWORDS = {
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch",
+    "char", "class", "compl", "concept", "const", "consteval", "constexpr", "constinit", "const_cast", "continue",
+    "co_await", "co_return", "co_yield", "decltype", "default", "delete", "do", "double", "dynamic_cast", "else",
+    "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long",
+    "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or", "or_eq", "private",
+    "protected", "public", "register", "reinterpret_cast", "requires", "return", "short", "signed", "sizeof",
+    "static", "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local", "throw", "true",
+    "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t",
+    "while", "xor", "xor_eq",
+    # member names of the generated register namespaces
+    "reg",
+}
+
+ACCESS = {
+    "read-only": "read_only",
+    "write-only": "write_only",
+    "read-write": "read_write",
+    "writeOnce": "write_only",
+    "read-writeOnce": "read_write",
+}
+
+
+def text(node, tag, default=None):
+    child = node.find(tag)
+    if child is None or child.text is None:
+        return default
+    return child.text.strip()
+
+
+def number(value):
+    value = value.strip().lower()
+    if value.startswith("#"):
+        return int(value[1:].replace("x", "0"), 2)
+    if value.startswith("0b"):
+        return int(value[2:], 2)
+    return int(value, 0)
+
+
+def describe(node):
+    return " ".join((text(node, "description", "") or "").split())
+
+
+class Names:
+    """Maps SVD names onto valid identifiers that do not clash with CMSIS macros."""
+
+    def __init__(self, reserved):
+        self.reserved = set(reserved) | CPP_KEYWORDS
+
+    def __call__(self, name):
+        ident = re.sub(r"\W", "_", name)
+        if ident[0].isdigit():
+            ident = "_" + ident
+        if ident in self.reserved:
+            ident += "_"
+        return ident
+
+
+def expand_dim(node, name):
+    """Expand SVD dim arrays into (name, offset) pairs."""
+    dim = text(node, "dim")
+    if dim is None:
+        return [(name, 0)]
+    count = number(dim)
+    increment = number(text(node, "dimIncrement", "0"))
+    index = text(node, "dimIndex")
+    if index is None:
+        indices = [str(i) for i in range(count)]
+    elif "-" in index and "," not in index:
+        first, last = index.split("-")
+        if first.isdigit():
+            indices = [str(i) for i in range(int(first), int(last) + 1)]
+        else:
+            indices = [chr(c) for c in range(ord(first), ord(last) + 1)]
+    else:
+        indices = index.split(",")
+    return [(name.replace("[%s]", idx).replace("%s", idx), i * increment) for i, idx in enumerate(indices)]
+
+
+def field_range(node):
+    if text(node, "bitOffset") is not None:
+        return number(text(node, "bitOffset")), number(text(node, "bitWidth", "1"))
+    if text(node, "lsb") is not None:
+        lsb = number(text(node, "lsb"))
+        return lsb, number(text(node, "msb")) - lsb + 1
+    msb, lsb = text(node, "bitRange").strip("[]").split(":")
+    return number(lsb), number(msb) - number(lsb) + 1
+
+
+def field_access(node, default):
+    access = ACCESS.get(text(node, "access", ""), default)
+    if text(node, "modifiedWriteValues") == "oneToClear" and access != "write_only":
+        access = "write_1_to_clear"
+    return access
+
+
+def collect_registers(node, defaults, offset=0, prefix=""):
+    """Flatten registers and clusters of a peripheral into a list of dicts."""
+    result = []
+    block = node.find("registers")
+    if block is None:
+        return result
+    for child in block:
+        if child.tag == "cluster":
+            base = offset + number(text(child, "addressOffset"))
+            for name, dim_offset in expand_dim(child, text(child, "name")):
+                result += collect_registers_in_cluster(child, defaults, base + dim_offset, prefix + name + "_")
+        elif child.tag == "register":
+            result += make_register(child, defaults, offset, prefix)
+    return result
+
+
+def collect_registers_in_cluster(cluster, defaults, offset, prefix):
+    wrapper = ET.Element("wrapper")
+    registers = ET.SubElement(wrapper, "registers")
+    registers.extend(list(cluster))
+    return collect_registers(wrapper, defaults, offset, prefix)
+
+
+def make_register(node, defaults, offset, prefix):
+    size = number(text(node, "size", str(defaults["size"])))
+    if size != 32:
+        print(f"svd2hpp: skipping {prefix}{text(node, 'name')}: {size} bit registers are not supported",
+              file=sys.stderr)
+        return []
+    access = ACCESS.get(text(node, "access", ""), defaults["access"])
+    reset = number(text(node, "resetValue", str(defaults["reset"])))
+
+    fields = []
+    fields_node = node.find("fields")
+    if fields_node is not None:
+        for field in fields_node.findall("field"):
+            pos, width = field_range(field)
+            for name, dim_offset in expand_dim(field, text(field, "name")):
+                fields.append({
+                    "name": name,
+                    "pos": pos + dim_offset,
+                    "width": width,
+                    "access": "read_only" if access == "read_only" else field_access(field, access),
+                    "description": describe(field),
+                })
+
+    result = []
+    for name, dim_offset in expand_dim(node, text(node, "name")):
+        result.append({
+            "name": prefix + name,
+            "offset": offset + number(text(node, "addressOffset")) + dim_offset,
+            "access": access,
+            "reset": reset,
+            "fields": fields,
+            "description": describe(node),
+        })
+    return result
+
+
+def field_mask(field):
+    return (((1 << field["width"]) - 1) << field["pos"]) & 0xFFFFFFFF
+
+
+def emit(device, namespace):
+    defaults = {
+        "size": number(text(device, "size", "32")),
+        "access": ACCESS.get(text(device, "access", ""), "read_write"),
+        "reset": number(text(device, "resetValue", "0")),
+    }
+    peripherals = device.find("peripherals").findall("peripheral")
+    by_name = {text(p, "name"): p for p in peripherals}
+    # CMSIS device headers define every peripheral instance and its base address as a macro
+    ident = Names([n for name in by_name for n in (name, name + "_BASE")])
+    # Peripheral namespaces are lower case, so no macro matches them; only avoid the names used alongside them
+    namespace_ident = Names(["access"])
+
+    out = []
+    out.append("/**")
+    out.append(f" * @file {device_name(device).lower()}_svd.hpp")
+    out.append(f" * @brief Register map of the {device_name(device)}, generated from its SVD file.")
+    out.append(" *")
+    out.append(" * Generated by tools/svd2hpp.py. Do not edit.")
+    out.append(" */")
+    out.append("#pragma once")
+    out.append("")
+    out.append("#include \"svd.hpp\"")
+    out.append("")
+    out.append(f"namespace {namespace}")
+    out.append("{")
+    out.append("\tusing mcal::svd::access;")
+
+    for peripheral in peripherals:
+        name = text(peripheral, "name")
+        base = number(text(peripheral, "baseAddress"))
+        source = peripheral
+        derived = peripheral.get("derivedFrom")
+        if derived is not None and peripheral.find("registers") is None:
+            source = by_name[derived]
+        local = dict(defaults)
+        local["size"] = number(text(source, "size", str(defaults["size"])))
+        local["access"] = ACCESS.get(text(source, "access", ""), defaults["access"])
+        local["reset"] = number(text(source, "resetValue", str(defaults["reset"])))
+        registers = collect_registers(source, local)
+
+        out.append("")
+        description = describe(peripheral) or describe(source)
+        out.append("\t/**")
+        out.append(f"\t * @brief {name}" + (f": {description}" if description else ""))
+        out.append("\t */")
+        out.append(f"\tnamespace {namespace_ident(name.lower())}")
+        out.append("\t{")
+        out.append(f"\t\tinline constexpr std::uint32_t base_address = 0x{base:08X}u; //!< Peripheral base address")
+        for register in registers:
+            fields = register["fields"]
+            implemented = 0xFFFFFFFF if not fields else 0
+            w1c = 0
+            for field in fields:
+                implemented |= field_mask(field)
+                if field["access"] == "write_1_to_clear":
+                    w1c |= field_mask(field)
+            out.append("")
+            out.append(f"\t\t/** @brief {register['description'] or register['name']} */")
+            out.append(f"\t\tnamespace {ident(register['name'])}")
+            out.append("\t\t{")
+            out.append(f"\t\t\tusing reg = mcal::svd::reg<0x{base + register['offset']:08X}u, "
+                       f"access::{register['access']}, 0x{register['reset']:08X}u, "
+                       f"0x{implemented:08X}u, 0x{w1c:08X}u>;")
+            for field in fields:
+                comment = f" //!< {field['description']}" if field["description"] else ""
+                out.append(f"\t\t\tusing {ident(field['name'])} = mcal::svd::field<reg, {field['pos']}, "
+                           f"{field['width']}, access::{field['access']}>;{comment}")
+            out.append(f"\t\t}} // namespace {ident(register['name'])}")
+        out.append(f"\t}} // namespace {namespace_ident(name.lower())}")
+
+    out.append(f"}} // namespace {namespace}")
+    out.append("")
+    return "\n".join(out)
+
+
+def device_name(device):
+    return text(device, "name", "device")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("svd", help="input SVD file")
+    parser.add_argument("output", help="generated C++ header")
+    parser.add_argument("--namespace", default="svd", help="C++ namespace of the register map")
+    args = parser.parse_args()
+
+    device = ET.parse(args.svd).getroot()
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(emit(device, args.namespace))
+
+
+if __name__ == "__main__":
+    main()